@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/dict_benchmark.cc" "bench/CMakeFiles/rime_benchmark.dir/dict_benchmark.cc.o" "gcc" "bench/CMakeFiles/rime_benchmark.dir/dict_benchmark.cc.o.d"
+  "/root/repo/bench/rime_benchmark_main.cc" "bench/CMakeFiles/rime_benchmark.dir/rime_benchmark_main.cc.o" "gcc" "bench/CMakeFiles/rime_benchmark.dir/rime_benchmark_main.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_rel/src/CMakeFiles/rime.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/rime_benchmark.dir/dict_benchmark.cc.o"
+  "CMakeFiles/rime_benchmark.dir/dict_benchmark.cc.o.d"
+  "CMakeFiles/rime_benchmark.dir/rime_benchmark_main.cc.o"
+  "CMakeFiles/rime_benchmark.dir/rime_benchmark_main.cc.o.d"
+  "rime_benchmark"
+  "rime_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
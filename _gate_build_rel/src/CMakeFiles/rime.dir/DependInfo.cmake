@@ -0,0 +1,134 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/rime/algo/algebra.cc" "src/CMakeFiles/rime.dir/rime/algo/algebra.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/algo/algebra.cc.o.d"
+  "/root/repo/src/rime/algo/calculus.cc" "src/CMakeFiles/rime.dir/rime/algo/calculus.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/algo/calculus.cc.o.d"
+  "/root/repo/src/rime/algo/encoder.cc" "src/CMakeFiles/rime.dir/rime/algo/encoder.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/algo/encoder.cc.o.d"
+  "/root/repo/src/rime/algo/spelling.cc" "src/CMakeFiles/rime.dir/rime/algo/spelling.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/algo/spelling.cc.o.d"
+  "/root/repo/src/rime/algo/strings.cc" "src/CMakeFiles/rime.dir/rime/algo/strings.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/algo/strings.cc.o.d"
+  "/root/repo/src/rime/algo/syllabifier.cc" "src/CMakeFiles/rime.dir/rime/algo/syllabifier.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/algo/syllabifier.cc.o.d"
+  "/root/repo/src/rime/algo/utilities.cc" "src/CMakeFiles/rime.dir/rime/algo/utilities.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/algo/utilities.cc.o.d"
+  "/root/repo/src/rime/candidate.cc" "src/CMakeFiles/rime.dir/rime/candidate.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/candidate.cc.o.d"
+  "/root/repo/src/rime/commit_history.cc" "src/CMakeFiles/rime.dir/rime/commit_history.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/commit_history.cc.o.d"
+  "/root/repo/src/rime/composition.cc" "src/CMakeFiles/rime.dir/rime/composition.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/composition.cc.o.d"
+  "/root/repo/src/rime/config/auto_patch_config_plugin.cc" "src/CMakeFiles/rime.dir/rime/config/auto_patch_config_plugin.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/auto_patch_config_plugin.cc.o.d"
+  "/root/repo/src/rime/config/build_info_plugin.cc" "src/CMakeFiles/rime.dir/rime/config/build_info_plugin.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/build_info_plugin.cc.o.d"
+  "/root/repo/src/rime/config/config_compiler.cc" "src/CMakeFiles/rime.dir/rime/config/config_compiler.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/config_compiler.cc.o.d"
+  "/root/repo/src/rime/config/config_component.cc" "src/CMakeFiles/rime.dir/rime/config/config_component.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/config_component.cc.o.d"
+  "/root/repo/src/rime/config/config_data.cc" "src/CMakeFiles/rime.dir/rime/config/config_data.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/config_data.cc.o.d"
+  "/root/repo/src/rime/config/config_image.cc" "src/CMakeFiles/rime.dir/rime/config/config_image.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/config_image.cc.o.d"
+  "/root/repo/src/rime/config/config_types.cc" "src/CMakeFiles/rime.dir/rime/config/config_types.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/config_types.cc.o.d"
+  "/root/repo/src/rime/config/default_config_plugin.cc" "src/CMakeFiles/rime.dir/rime/config/default_config_plugin.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/default_config_plugin.cc.o.d"
+  "/root/repo/src/rime/config/legacy_dictionary_config_plugin.cc" "src/CMakeFiles/rime.dir/rime/config/legacy_dictionary_config_plugin.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/legacy_dictionary_config_plugin.cc.o.d"
+  "/root/repo/src/rime/config/legacy_preset_config_plugin.cc" "src/CMakeFiles/rime.dir/rime/config/legacy_preset_config_plugin.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/legacy_preset_config_plugin.cc.o.d"
+  "/root/repo/src/rime/config/save_output_plugin.cc" "src/CMakeFiles/rime.dir/rime/config/save_output_plugin.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/config/save_output_plugin.cc.o.d"
+  "/root/repo/src/rime/context.cc" "src/CMakeFiles/rime.dir/rime/context.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/context.cc.o.d"
+  "/root/repo/src/rime/core_module.cc" "src/CMakeFiles/rime.dir/rime/core_module.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/core_module.cc.o.d"
+  "/root/repo/src/rime/deployer.cc" "src/CMakeFiles/rime.dir/rime/deployer.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/deployer.cc.o.d"
+  "/root/repo/src/rime/dict/corrector.cc" "src/CMakeFiles/rime.dir/rime/dict/corrector.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/corrector.cc.o.d"
+  "/root/repo/src/rime/dict/db.cc" "src/CMakeFiles/rime.dir/rime/dict/db.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/db.cc.o.d"
+  "/root/repo/src/rime/dict/db_utils.cc" "src/CMakeFiles/rime.dir/rime/dict/db_utils.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/db_utils.cc.o.d"
+  "/root/repo/src/rime/dict/dict_compiler.cc" "src/CMakeFiles/rime.dir/rime/dict/dict_compiler.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/dict_compiler.cc.o.d"
+  "/root/repo/src/rime/dict/dict_module.cc" "src/CMakeFiles/rime.dir/rime/dict/dict_module.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/dict_module.cc.o.d"
+  "/root/repo/src/rime/dict/dict_settings.cc" "src/CMakeFiles/rime.dir/rime/dict/dict_settings.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/dict_settings.cc.o.d"
+  "/root/repo/src/rime/dict/dictionary.cc" "src/CMakeFiles/rime.dir/rime/dict/dictionary.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/dictionary.cc.o.d"
+  "/root/repo/src/rime/dict/entry_collector.cc" "src/CMakeFiles/rime.dir/rime/dict/entry_collector.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/entry_collector.cc.o.d"
+  "/root/repo/src/rime/dict/level_db.cc" "src/CMakeFiles/rime.dir/rime/dict/level_db.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/level_db.cc.o.d"
+  "/root/repo/src/rime/dict/mapped_file.cc" "src/CMakeFiles/rime.dir/rime/dict/mapped_file.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/mapped_file.cc.o.d"
+  "/root/repo/src/rime/dict/preset_vocabulary.cc" "src/CMakeFiles/rime.dir/rime/dict/preset_vocabulary.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/preset_vocabulary.cc.o.d"
+  "/root/repo/src/rime/dict/prism.cc" "src/CMakeFiles/rime.dir/rime/dict/prism.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/prism.cc.o.d"
+  "/root/repo/src/rime/dict/resource_preloading_task.cc" "src/CMakeFiles/rime.dir/rime/dict/resource_preloading_task.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/resource_preloading_task.cc.o.d"
+  "/root/repo/src/rime/dict/reverse_lookup_dictionary.cc" "src/CMakeFiles/rime.dir/rime/dict/reverse_lookup_dictionary.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/reverse_lookup_dictionary.cc.o.d"
+  "/root/repo/src/rime/dict/string_table.cc" "src/CMakeFiles/rime.dir/rime/dict/string_table.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/string_table.cc.o.d"
+  "/root/repo/src/rime/dict/table.cc" "src/CMakeFiles/rime.dir/rime/dict/table.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/table.cc.o.d"
+  "/root/repo/src/rime/dict/table_db.cc" "src/CMakeFiles/rime.dir/rime/dict/table_db.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/table_db.cc.o.d"
+  "/root/repo/src/rime/dict/text_db.cc" "src/CMakeFiles/rime.dir/rime/dict/text_db.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/text_db.cc.o.d"
+  "/root/repo/src/rime/dict/tsv.cc" "src/CMakeFiles/rime.dir/rime/dict/tsv.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/tsv.cc.o.d"
+  "/root/repo/src/rime/dict/user_db.cc" "src/CMakeFiles/rime.dir/rime/dict/user_db.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/user_db.cc.o.d"
+  "/root/repo/src/rime/dict/user_db_delta.cc" "src/CMakeFiles/rime.dir/rime/dict/user_db_delta.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/user_db_delta.cc.o.d"
+  "/root/repo/src/rime/dict/user_db_recovery_task.cc" "src/CMakeFiles/rime.dir/rime/dict/user_db_recovery_task.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/user_db_recovery_task.cc.o.d"
+  "/root/repo/src/rime/dict/user_dictionary.cc" "src/CMakeFiles/rime.dir/rime/dict/user_dictionary.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/user_dictionary.cc.o.d"
+  "/root/repo/src/rime/dict/vocabulary.cc" "src/CMakeFiles/rime.dir/rime/dict/vocabulary.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/dict/vocabulary.cc.o.d"
+  "/root/repo/src/rime/engine.cc" "src/CMakeFiles/rime.dir/rime/engine.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/engine.cc.o.d"
+  "/root/repo/src/rime/gear/abc_segmentor.cc" "src/CMakeFiles/rime.dir/rime/gear/abc_segmentor.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/abc_segmentor.cc.o.d"
+  "/root/repo/src/rime/gear/affix_segmentor.cc" "src/CMakeFiles/rime.dir/rime/gear/affix_segmentor.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/affix_segmentor.cc.o.d"
+  "/root/repo/src/rime/gear/ascii_composer.cc" "src/CMakeFiles/rime.dir/rime/gear/ascii_composer.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/ascii_composer.cc.o.d"
+  "/root/repo/src/rime/gear/ascii_segmentor.cc" "src/CMakeFiles/rime.dir/rime/gear/ascii_segmentor.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/ascii_segmentor.cc.o.d"
+  "/root/repo/src/rime/gear/charset_filter.cc" "src/CMakeFiles/rime.dir/rime/gear/charset_filter.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/charset_filter.cc.o.d"
+  "/root/repo/src/rime/gear/chord_composer.cc" "src/CMakeFiles/rime.dir/rime/gear/chord_composer.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/chord_composer.cc.o.d"
+  "/root/repo/src/rime/gear/contextual_translation.cc" "src/CMakeFiles/rime.dir/rime/gear/contextual_translation.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/contextual_translation.cc.o.d"
+  "/root/repo/src/rime/gear/echo_translator.cc" "src/CMakeFiles/rime.dir/rime/gear/echo_translator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/echo_translator.cc.o.d"
+  "/root/repo/src/rime/gear/editor.cc" "src/CMakeFiles/rime.dir/rime/gear/editor.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/editor.cc.o.d"
+  "/root/repo/src/rime/gear/fallback_segmentor.cc" "src/CMakeFiles/rime.dir/rime/gear/fallback_segmentor.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/fallback_segmentor.cc.o.d"
+  "/root/repo/src/rime/gear/filter_commons.cc" "src/CMakeFiles/rime.dir/rime/gear/filter_commons.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/filter_commons.cc.o.d"
+  "/root/repo/src/rime/gear/gears_module.cc" "src/CMakeFiles/rime.dir/rime/gear/gears_module.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/gears_module.cc.o.d"
+  "/root/repo/src/rime/gear/history_translator.cc" "src/CMakeFiles/rime.dir/rime/gear/history_translator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/history_translator.cc.o.d"
+  "/root/repo/src/rime/gear/key_binder.cc" "src/CMakeFiles/rime.dir/rime/gear/key_binder.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/key_binder.cc.o.d"
+  "/root/repo/src/rime/gear/matcher.cc" "src/CMakeFiles/rime.dir/rime/gear/matcher.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/matcher.cc.o.d"
+  "/root/repo/src/rime/gear/memory.cc" "src/CMakeFiles/rime.dir/rime/gear/memory.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/memory.cc.o.d"
+  "/root/repo/src/rime/gear/navigator.cc" "src/CMakeFiles/rime.dir/rime/gear/navigator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/navigator.cc.o.d"
+  "/root/repo/src/rime/gear/poet.cc" "src/CMakeFiles/rime.dir/rime/gear/poet.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/poet.cc.o.d"
+  "/root/repo/src/rime/gear/punctuator.cc" "src/CMakeFiles/rime.dir/rime/gear/punctuator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/punctuator.cc.o.d"
+  "/root/repo/src/rime/gear/recognizer.cc" "src/CMakeFiles/rime.dir/rime/gear/recognizer.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/recognizer.cc.o.d"
+  "/root/repo/src/rime/gear/reverse_lookup_filter.cc" "src/CMakeFiles/rime.dir/rime/gear/reverse_lookup_filter.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/reverse_lookup_filter.cc.o.d"
+  "/root/repo/src/rime/gear/reverse_lookup_translator.cc" "src/CMakeFiles/rime.dir/rime/gear/reverse_lookup_translator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/reverse_lookup_translator.cc.o.d"
+  "/root/repo/src/rime/gear/schema_list_translator.cc" "src/CMakeFiles/rime.dir/rime/gear/schema_list_translator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/schema_list_translator.cc.o.d"
+  "/root/repo/src/rime/gear/script_translator.cc" "src/CMakeFiles/rime.dir/rime/gear/script_translator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/script_translator.cc.o.d"
+  "/root/repo/src/rime/gear/selector.cc" "src/CMakeFiles/rime.dir/rime/gear/selector.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/selector.cc.o.d"
+  "/root/repo/src/rime/gear/shape.cc" "src/CMakeFiles/rime.dir/rime/gear/shape.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/shape.cc.o.d"
+  "/root/repo/src/rime/gear/simplifier.cc" "src/CMakeFiles/rime.dir/rime/gear/simplifier.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/simplifier.cc.o.d"
+  "/root/repo/src/rime/gear/single_char_filter.cc" "src/CMakeFiles/rime.dir/rime/gear/single_char_filter.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/single_char_filter.cc.o.d"
+  "/root/repo/src/rime/gear/speller.cc" "src/CMakeFiles/rime.dir/rime/gear/speller.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/speller.cc.o.d"
+  "/root/repo/src/rime/gear/switch_translator.cc" "src/CMakeFiles/rime.dir/rime/gear/switch_translator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/switch_translator.cc.o.d"
+  "/root/repo/src/rime/gear/table_translator.cc" "src/CMakeFiles/rime.dir/rime/gear/table_translator.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/table_translator.cc.o.d"
+  "/root/repo/src/rime/gear/translator_commons.cc" "src/CMakeFiles/rime.dir/rime/gear/translator_commons.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/translator_commons.cc.o.d"
+  "/root/repo/src/rime/gear/uniquifier.cc" "src/CMakeFiles/rime.dir/rime/gear/uniquifier.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/uniquifier.cc.o.d"
+  "/root/repo/src/rime/gear/unity_table_encoder.cc" "src/CMakeFiles/rime.dir/rime/gear/unity_table_encoder.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/gear/unity_table_encoder.cc.o.d"
+  "/root/repo/src/rime/key_event.cc" "src/CMakeFiles/rime.dir/rime/key_event.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/key_event.cc.o.d"
+  "/root/repo/src/rime/key_table.cc" "src/CMakeFiles/rime.dir/rime/key_table.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/key_table.cc.o.d"
+  "/root/repo/src/rime/language.cc" "src/CMakeFiles/rime.dir/rime/language.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/language.cc.o.d"
+  "/root/repo/src/rime/lever/custom_settings.cc" "src/CMakeFiles/rime.dir/rime/lever/custom_settings.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/lever/custom_settings.cc.o.d"
+  "/root/repo/src/rime/lever/customizer.cc" "src/CMakeFiles/rime.dir/rime/lever/customizer.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/lever/customizer.cc.o.d"
+  "/root/repo/src/rime/lever/deployment_tasks.cc" "src/CMakeFiles/rime.dir/rime/lever/deployment_tasks.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/lever/deployment_tasks.cc.o.d"
+  "/root/repo/src/rime/lever/levers_module.cc" "src/CMakeFiles/rime.dir/rime/lever/levers_module.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/lever/levers_module.cc.o.d"
+  "/root/repo/src/rime/lever/levers_stdbool.cc" "src/CMakeFiles/rime.dir/rime/lever/levers_stdbool.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/lever/levers_stdbool.cc.o.d"
+  "/root/repo/src/rime/lever/switcher_settings.cc" "src/CMakeFiles/rime.dir/rime/lever/switcher_settings.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/lever/switcher_settings.cc.o.d"
+  "/root/repo/src/rime/lever/user_dict_manager.cc" "src/CMakeFiles/rime.dir/rime/lever/user_dict_manager.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/lever/user_dict_manager.cc.o.d"
+  "/root/repo/src/rime/menu.cc" "src/CMakeFiles/rime.dir/rime/menu.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/menu.cc.o.d"
+  "/root/repo/src/rime/module.cc" "src/CMakeFiles/rime.dir/rime/module.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/module.cc.o.d"
+  "/root/repo/src/rime/registry.cc" "src/CMakeFiles/rime.dir/rime/registry.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/registry.cc.o.d"
+  "/root/repo/src/rime/resource.cc" "src/CMakeFiles/rime.dir/rime/resource.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/resource.cc.o.d"
+  "/root/repo/src/rime/schema.cc" "src/CMakeFiles/rime.dir/rime/schema.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/schema.cc.o.d"
+  "/root/repo/src/rime/segmentation.cc" "src/CMakeFiles/rime.dir/rime/segmentation.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/segmentation.cc.o.d"
+  "/root/repo/src/rime/service.cc" "src/CMakeFiles/rime.dir/rime/service.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/service.cc.o.d"
+  "/root/repo/src/rime/setup.cc" "src/CMakeFiles/rime.dir/rime/setup.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/setup.cc.o.d"
+  "/root/repo/src/rime/signature.cc" "src/CMakeFiles/rime.dir/rime/signature.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/signature.cc.o.d"
+  "/root/repo/src/rime/switcher.cc" "src/CMakeFiles/rime.dir/rime/switcher.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/switcher.cc.o.d"
+  "/root/repo/src/rime/switches.cc" "src/CMakeFiles/rime.dir/rime/switches.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/switches.cc.o.d"
+  "/root/repo/src/rime/ticket.cc" "src/CMakeFiles/rime.dir/rime/ticket.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/ticket.cc.o.d"
+  "/root/repo/src/rime/tracer.cc" "src/CMakeFiles/rime.dir/rime/tracer.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/tracer.cc.o.d"
+  "/root/repo/src/rime/translation.cc" "src/CMakeFiles/rime.dir/rime/translation.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime/translation.cc.o.d"
+  "/root/repo/src/rime_api.cc" "src/CMakeFiles/rime.dir/rime_api.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime_api.cc.o.d"
+  "/root/repo/src/rime_api_stdbool.cc" "src/CMakeFiles/rime.dir/rime_api_stdbool.cc.o" "gcc" "src/CMakeFiles/rime.dir/rime_api_stdbool.cc.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_gate_build_rel/lib/librime.so" "/root/repo/_gate_build_rel/lib/librime.so.1.17.0"
+  "/root/repo/_gate_build_rel/lib/librime.so.1" "/root/repo/_gate_build_rel/lib/librime.so.1.17.0"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,229 @@
+file(REMOVE_RECURSE
+  "../lib/librime.pdb"
+  "../lib/librime.so"
+  "../lib/librime.so.1"
+  "../lib/librime.so.1.17.0"
+  "CMakeFiles/rime.dir/rime/algo/algebra.cc.o"
+  "CMakeFiles/rime.dir/rime/algo/algebra.cc.o.d"
+  "CMakeFiles/rime.dir/rime/algo/calculus.cc.o"
+  "CMakeFiles/rime.dir/rime/algo/calculus.cc.o.d"
+  "CMakeFiles/rime.dir/rime/algo/encoder.cc.o"
+  "CMakeFiles/rime.dir/rime/algo/encoder.cc.o.d"
+  "CMakeFiles/rime.dir/rime/algo/spelling.cc.o"
+  "CMakeFiles/rime.dir/rime/algo/spelling.cc.o.d"
+  "CMakeFiles/rime.dir/rime/algo/strings.cc.o"
+  "CMakeFiles/rime.dir/rime/algo/strings.cc.o.d"
+  "CMakeFiles/rime.dir/rime/algo/syllabifier.cc.o"
+  "CMakeFiles/rime.dir/rime/algo/syllabifier.cc.o.d"
+  "CMakeFiles/rime.dir/rime/algo/utilities.cc.o"
+  "CMakeFiles/rime.dir/rime/algo/utilities.cc.o.d"
+  "CMakeFiles/rime.dir/rime/candidate.cc.o"
+  "CMakeFiles/rime.dir/rime/candidate.cc.o.d"
+  "CMakeFiles/rime.dir/rime/commit_history.cc.o"
+  "CMakeFiles/rime.dir/rime/commit_history.cc.o.d"
+  "CMakeFiles/rime.dir/rime/composition.cc.o"
+  "CMakeFiles/rime.dir/rime/composition.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/auto_patch_config_plugin.cc.o"
+  "CMakeFiles/rime.dir/rime/config/auto_patch_config_plugin.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/build_info_plugin.cc.o"
+  "CMakeFiles/rime.dir/rime/config/build_info_plugin.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/config_compiler.cc.o"
+  "CMakeFiles/rime.dir/rime/config/config_compiler.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/config_component.cc.o"
+  "CMakeFiles/rime.dir/rime/config/config_component.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/config_data.cc.o"
+  "CMakeFiles/rime.dir/rime/config/config_data.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/config_image.cc.o"
+  "CMakeFiles/rime.dir/rime/config/config_image.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/config_types.cc.o"
+  "CMakeFiles/rime.dir/rime/config/config_types.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/default_config_plugin.cc.o"
+  "CMakeFiles/rime.dir/rime/config/default_config_plugin.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/legacy_dictionary_config_plugin.cc.o"
+  "CMakeFiles/rime.dir/rime/config/legacy_dictionary_config_plugin.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/legacy_preset_config_plugin.cc.o"
+  "CMakeFiles/rime.dir/rime/config/legacy_preset_config_plugin.cc.o.d"
+  "CMakeFiles/rime.dir/rime/config/save_output_plugin.cc.o"
+  "CMakeFiles/rime.dir/rime/config/save_output_plugin.cc.o.d"
+  "CMakeFiles/rime.dir/rime/context.cc.o"
+  "CMakeFiles/rime.dir/rime/context.cc.o.d"
+  "CMakeFiles/rime.dir/rime/core_module.cc.o"
+  "CMakeFiles/rime.dir/rime/core_module.cc.o.d"
+  "CMakeFiles/rime.dir/rime/deployer.cc.o"
+  "CMakeFiles/rime.dir/rime/deployer.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/corrector.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/corrector.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/db.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/db.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/db_utils.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/db_utils.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/dict_compiler.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/dict_compiler.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/dict_module.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/dict_module.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/dict_settings.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/dict_settings.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/dictionary.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/dictionary.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/entry_collector.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/entry_collector.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/level_db.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/level_db.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/mapped_file.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/mapped_file.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/preset_vocabulary.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/preset_vocabulary.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/prism.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/prism.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/resource_preloading_task.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/resource_preloading_task.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/reverse_lookup_dictionary.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/reverse_lookup_dictionary.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/string_table.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/string_table.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/table.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/table.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/table_db.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/table_db.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/text_db.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/text_db.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/tsv.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/tsv.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/user_db.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/user_db.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/user_db_delta.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/user_db_delta.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/user_db_recovery_task.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/user_db_recovery_task.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/user_dictionary.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/user_dictionary.cc.o.d"
+  "CMakeFiles/rime.dir/rime/dict/vocabulary.cc.o"
+  "CMakeFiles/rime.dir/rime/dict/vocabulary.cc.o.d"
+  "CMakeFiles/rime.dir/rime/engine.cc.o"
+  "CMakeFiles/rime.dir/rime/engine.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/abc_segmentor.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/abc_segmentor.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/affix_segmentor.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/affix_segmentor.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/ascii_composer.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/ascii_composer.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/ascii_segmentor.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/ascii_segmentor.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/charset_filter.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/charset_filter.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/chord_composer.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/chord_composer.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/contextual_translation.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/contextual_translation.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/echo_translator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/echo_translator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/editor.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/editor.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/fallback_segmentor.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/fallback_segmentor.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/filter_commons.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/filter_commons.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/gears_module.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/gears_module.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/history_translator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/history_translator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/key_binder.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/key_binder.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/matcher.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/matcher.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/memory.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/memory.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/navigator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/navigator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/poet.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/poet.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/punctuator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/punctuator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/recognizer.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/recognizer.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/reverse_lookup_filter.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/reverse_lookup_filter.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/reverse_lookup_translator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/reverse_lookup_translator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/schema_list_translator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/schema_list_translator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/script_translator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/script_translator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/selector.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/selector.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/shape.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/shape.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/simplifier.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/simplifier.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/single_char_filter.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/single_char_filter.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/speller.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/speller.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/switch_translator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/switch_translator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/table_translator.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/table_translator.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/translator_commons.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/translator_commons.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/uniquifier.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/uniquifier.cc.o.d"
+  "CMakeFiles/rime.dir/rime/gear/unity_table_encoder.cc.o"
+  "CMakeFiles/rime.dir/rime/gear/unity_table_encoder.cc.o.d"
+  "CMakeFiles/rime.dir/rime/key_event.cc.o"
+  "CMakeFiles/rime.dir/rime/key_event.cc.o.d"
+  "CMakeFiles/rime.dir/rime/key_table.cc.o"
+  "CMakeFiles/rime.dir/rime/key_table.cc.o.d"
+  "CMakeFiles/rime.dir/rime/language.cc.o"
+  "CMakeFiles/rime.dir/rime/language.cc.o.d"
+  "CMakeFiles/rime.dir/rime/lever/custom_settings.cc.o"
+  "CMakeFiles/rime.dir/rime/lever/custom_settings.cc.o.d"
+  "CMakeFiles/rime.dir/rime/lever/customizer.cc.o"
+  "CMakeFiles/rime.dir/rime/lever/customizer.cc.o.d"
+  "CMakeFiles/rime.dir/rime/lever/deployment_tasks.cc.o"
+  "CMakeFiles/rime.dir/rime/lever/deployment_tasks.cc.o.d"
+  "CMakeFiles/rime.dir/rime/lever/levers_module.cc.o"
+  "CMakeFiles/rime.dir/rime/lever/levers_module.cc.o.d"
+  "CMakeFiles/rime.dir/rime/lever/levers_stdbool.cc.o"
+  "CMakeFiles/rime.dir/rime/lever/levers_stdbool.cc.o.d"
+  "CMakeFiles/rime.dir/rime/lever/switcher_settings.cc.o"
+  "CMakeFiles/rime.dir/rime/lever/switcher_settings.cc.o.d"
+  "CMakeFiles/rime.dir/rime/lever/user_dict_manager.cc.o"
+  "CMakeFiles/rime.dir/rime/lever/user_dict_manager.cc.o.d"
+  "CMakeFiles/rime.dir/rime/menu.cc.o"
+  "CMakeFiles/rime.dir/rime/menu.cc.o.d"
+  "CMakeFiles/rime.dir/rime/module.cc.o"
+  "CMakeFiles/rime.dir/rime/module.cc.o.d"
+  "CMakeFiles/rime.dir/rime/registry.cc.o"
+  "CMakeFiles/rime.dir/rime/registry.cc.o.d"
+  "CMakeFiles/rime.dir/rime/resource.cc.o"
+  "CMakeFiles/rime.dir/rime/resource.cc.o.d"
+  "CMakeFiles/rime.dir/rime/schema.cc.o"
+  "CMakeFiles/rime.dir/rime/schema.cc.o.d"
+  "CMakeFiles/rime.dir/rime/segmentation.cc.o"
+  "CMakeFiles/rime.dir/rime/segmentation.cc.o.d"
+  "CMakeFiles/rime.dir/rime/service.cc.o"
+  "CMakeFiles/rime.dir/rime/service.cc.o.d"
+  "CMakeFiles/rime.dir/rime/setup.cc.o"
+  "CMakeFiles/rime.dir/rime/setup.cc.o.d"
+  "CMakeFiles/rime.dir/rime/signature.cc.o"
+  "CMakeFiles/rime.dir/rime/signature.cc.o.d"
+  "CMakeFiles/rime.dir/rime/switcher.cc.o"
+  "CMakeFiles/rime.dir/rime/switcher.cc.o.d"
+  "CMakeFiles/rime.dir/rime/switches.cc.o"
+  "CMakeFiles/rime.dir/rime/switches.cc.o.d"
+  "CMakeFiles/rime.dir/rime/ticket.cc.o"
+  "CMakeFiles/rime.dir/rime/ticket.cc.o.d"
+  "CMakeFiles/rime.dir/rime/tracer.cc.o"
+  "CMakeFiles/rime.dir/rime/tracer.cc.o.d"
+  "CMakeFiles/rime.dir/rime/translation.cc.o"
+  "CMakeFiles/rime.dir/rime/translation.cc.o.d"
+  "CMakeFiles/rime.dir/rime_api.cc.o"
+  "CMakeFiles/rime.dir/rime_api.cc.o.d"
+  "CMakeFiles/rime.dir/rime_api_stdbool.cc.o"
+  "CMakeFiles/rime.dir/rime_api_stdbool.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,14 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#ifndef RIME_BUILD_CONFIG_H_
+#define RIME_BUILD_CONFIG_H_
+
+/* #undef RIME_ENABLE_LOGGING */
+/* #undef RIME_ALSO_LOG_TO_STDERR */
+
+#define RIME_DATA_DIR "rime-data"
+#define RIME_PLUGINS_DIR "rime-plugins"
+
+#endif  // RIME_BUILD_CONFIG_H_
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tools/line_editor.cc" "tools/CMakeFiles/rime_api_console.dir/line_editor.cc.o" "gcc" "tools/CMakeFiles/rime_api_console.dir/line_editor.cc.o.d"
+  "/root/repo/tools/rime_api_console.cc" "tools/CMakeFiles/rime_api_console.dir/rime_api_console.cc.o" "gcc" "tools/CMakeFiles/rime_api_console.dir/rime_api_console.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_rel/src/CMakeFiles/rime.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../bin/rime_api_console"
+  "../bin/rime_api_console.pdb"
+  "CMakeFiles/rime_api_console.dir/line_editor.cc.o"
+  "CMakeFiles/rime_api_console.dir/line_editor.cc.o.d"
+  "CMakeFiles/rime_api_console.dir/rime_api_console.cc.o"
+  "CMakeFiles/rime_api_console.dir/rime_api_console.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime_api_console.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/rime_bench"
+  "../bin/rime_bench.pdb"
+  "CMakeFiles/rime_bench.dir/rime_bench.cc.o"
+  "CMakeFiles/rime_bench.dir/rime_bench.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/rime_console"
+  "../bin/rime_console.pdb"
+  "CMakeFiles/rime_console.dir/rime_console.cc.o"
+  "CMakeFiles/rime_console.dir/rime_console.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime_console.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
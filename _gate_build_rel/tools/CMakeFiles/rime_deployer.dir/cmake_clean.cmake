@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/rime_deployer"
+  "../bin/rime_deployer.pdb"
+  "CMakeFiles/rime_deployer.dir/rime_deployer.cc.o"
+  "CMakeFiles/rime_deployer.dir/rime_deployer.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime_deployer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/rime_dict_manager"
+  "../bin/rime_dict_manager.pdb"
+  "CMakeFiles/rime_dict_manager.dir/rime_dict_manager.cc.o"
+  "CMakeFiles/rime_dict_manager.dir/rime_dict_manager.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime_dict_manager.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
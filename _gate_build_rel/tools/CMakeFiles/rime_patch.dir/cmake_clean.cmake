@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/rime_patch"
+  "../bin/rime_patch.pdb"
+  "CMakeFiles/rime_patch.dir/rime_patch.cc.o"
+  "CMakeFiles/rime_patch.dir/rime_patch.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime_patch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/rime_table_decompiler"
+  "../bin/rime_table_decompiler.pdb"
+  "CMakeFiles/rime_table_decompiler.dir/rime_table_decompiler.cc.o"
+  "CMakeFiles/rime_table_decompiler.dir/rime_table_decompiler.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rime_table_decompiler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
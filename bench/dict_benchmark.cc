@@ -0,0 +1,451 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+// Micro-benchmarks of the dictionary layer. Each benchmark runs on a synthetic
+// dictionary and on luna_pinyin from data/minimal, selected by the first
+// argument.
+//
+#include <random>
+#include <benchmark/benchmark.h>
+#include <rime/common.h>
+#include <rime/language.h>
+#include <rime/algo/syllabifier.h>
+#include <rime/dict/db.h>
+#include <rime/dict/dict_compiler.h>
+#include <rime/dict/dictionary.h>
+#include <rime/dict/prism.h>
+#include <rime/dict/string_table.h>
+#include <rime/dict/table.h>
+#include <rime/dict/user_dictionary.h>
+#include <rime/gear/poet.h>
+#include <rime/gear/translator_commons.h>
+
+using namespace rime;
+
+namespace {
+
+enum DataSet {
+  kSynthetic,
+  kLunaPinyin,
+};
+
+// a pinyin-like syllabary, 24 x 30 syllables
+const char* kInitials[] = {
+    "", "b", "p", "m", "f", "d", "t", "n", "l", "g", "k", "h", "j", "q", "x",
+    "zh", "ch", "sh", "r", "z", "c", "s", "y", "w",
+};
+const char* kFinals[] = {
+    "a", "o", "e", "i", "u", "v", "ai", "ei", "ao", "ou", "an", "en", "ang",
+    "eng", "ong", "ia", "ie", "iao", "iu", "ian", "in", "iang", "ing", "ua",
+    "uo", "uai", "ui", "uan", "un", "uang",
+};
+
+const int kSyntheticEntries = 200000;
+const int kSyntheticInputs = 200;
+const size_t kMaxSyllablesForUserPhraseQuery = 5;
+const size_t kMaxHomophones = 1;
+
+// the same kind of input a user would type, with and without a complete
+// final syllable.
+const char* kLunaPinyinInputs[] = {
+    "a",
+    "zh",
+    "ni",
+    "nihao",
+    "zhongguo",
+    "zhongg",
+    "shurufa",
+    "pinyinshurufa",
+    "xian",
+    "xiangang",
+    "jintian",
+    "jintiantianqibucuo",
+    "woshizhongguoren",
+    "womenyiqiqukanyanchanghui",
+    "zuijinzenmeyang",
+    "kexuejishu",
+};
+
+struct DictData {
+  the<Dictionary> dict;
+  an<UserDictionary> user_dict;
+  vector<string> inputs;
+  vector<SyllableGraph> graphs;
+  // entries found by the inputs, for updating the user dictionary
+  vector<an<DictEntry>> entries;
+  the<StringTableBuilder> string_table;
+  vector<StringId> string_ids;
+};
+
+string DataSetName(int data_set) {
+  return data_set == kSynthetic ? "synthetic" : "luna_pinyin";
+}
+
+bool BuildSyntheticDictionary(const string& name, vector<string>* inputs) {
+  Syllabary syllabary;
+  for (const char* initial : kInitials) {
+    for (const char* rhyme : kFinals) {
+      syllabary.insert(string(initial) + rhyme);
+    }
+  }
+  // syllable ids are assigned in the order of the syllabary.
+  vector<string> syllables(syllabary.begin(), syllabary.end());
+  std::mt19937 rng(20111);
+  std::uniform_int_distribution<int> syllable(0, syllables.size() - 1);
+  std::uniform_int_distribution<int> code_length(1, 4);
+  std::uniform_real_distribution<double> weight(1.0, 10000.0);
+  Vocabulary vocabulary;
+  for (int i = 0; i < kSyntheticEntries; ++i) {
+    auto entry = New<ShortDictEntry>();
+    int length = code_length(rng);
+    for (int k = 0; k < length; ++k) {
+      entry->code.push_back(syllable(rng));
+    }
+    entry->text = "w" + std::to_string(i);
+    entry->weight = weight(rng);
+    vocabulary.LocateEntries(entry->code)->push_back(entry);
+  }
+  vocabulary.SortHomophones();
+  for (int i = 0; i < kSyntheticInputs; ++i) {
+    string input;
+    int length = 1 + i % 6;
+    for (int k = 0; k < length; ++k) {
+      input += syllables[syllable(rng)];
+    }
+    inputs->push_back(input);
+  }
+  Prism prism(path{name + ".prism.bin"});
+  Table table(path{name + ".table.bin"});
+  prism.Remove();
+  table.Remove();
+  return prism.Build(syllabary) && prism.Save() &&
+         table.Build(syllabary, vocabulary, kSyntheticEntries) &&
+         table.Save();
+}
+
+an<UserDictionary> CreateUserDictionary(const string& name,
+                                        Dictionary* dict,
+                                        const vector<an<DictEntry>>& entries) {
+  auto component = Db::Require("userdb");
+  if (!component)
+    return nullptr;
+  an<Db> db(component->Create(name));
+  if (db->Exists())
+    db->Remove();
+  auto user_dict = New<UserDictionary>(name, db);
+  user_dict->Attach(dict->primary_table(), dict->prism());
+  if (!user_dict->Load())
+    return nullptr;
+  for (const auto& entry : entries) {
+    user_dict->UpdateEntry(*entry, 1);
+  }
+  return user_dict;
+}
+
+the<DictData> LoadDictData(int data_set) {
+  the<DictData> data(new DictData);
+  string name = "bench_" + DataSetName(data_set);
+  if (data_set == kSynthetic) {
+    if (!BuildSyntheticDictionary(name, &data->inputs))
+      return nullptr;
+  } else {
+    for (const char* input : kLunaPinyinInputs) {
+      data->inputs.push_back(input);
+    }
+  }
+  data->dict.reset(new Dictionary(
+      data_set == kSynthetic ? name : "luna_pinyin", {},
+      {New<Table>(path{name + ".table.bin"})},
+      New<Prism>(path{name + ".prism.bin"})));
+  if (data_set == kLunaPinyin) {
+    // compiles luna_pinyin.dict.yaml in the working directory.
+    DictCompiler dict_compiler(data->dict.get());
+    if (!dict_compiler.Compile(path()))
+      return nullptr;
+  }
+  if (!data->dict->Load())
+    return nullptr;
+  Syllabifier syllabifier("'", true);
+  for (const auto& input : data->inputs) {
+    SyllableGraph graph;
+    syllabifier.BuildSyllableGraph(input, *data->dict->prism(), &graph);
+    data->graphs.push_back(graph);
+    if (auto collector = data->dict->Lookup(graph, 0)) {
+      for (auto& x : *collector) {
+        if (!x.second.exhausted())
+          data->entries.push_back(x.second.Peek());
+      }
+    }
+  }
+  // the texts of single-syllable words make the string table.
+  data->string_table.reset(new StringTableBuilder);
+  const auto& table = data->dict->primary_table();
+  for (int syllable_id = 0;
+       syllable_id < int(table->metadata()->num_syllables); ++syllable_id) {
+    auto accessor = table->QueryWords(syllable_id);
+    for (; !accessor.exhausted(); accessor.Next()) {
+      data->string_table->Add(table->GetEntryText(*accessor.entry()));
+    }
+  }
+  data->string_table->Build();
+  std::mt19937 rng(20140625);
+  std::uniform_int_distribution<StringId> string_id(
+      0, data->string_table->NumKeys() - 1);
+  for (int i = 0; i < 1024; ++i) {
+    data->string_ids.push_back(string_id(rng));
+  }
+  data->user_dict =
+      CreateUserDictionary(name, data->dict.get(), data->entries);
+  return data;
+}
+
+// loaded once per data set; nullptr on failure.
+DictData* GetDictData(benchmark::State& state) {
+  static map<int, the<DictData>> cache;
+  int data_set = state.range(0);
+  auto found = cache.find(data_set);
+  if (found == cache.end()) {
+    found = cache.emplace(data_set, LoadDictData(data_set)).first;
+  }
+  DictData* data = found->second.get();
+  if (!data) {
+    state.SkipWithError(("error loading " + DataSetName(data_set)).c_str());
+  } else {
+    state.SetLabel(DataSetName(data_set));
+  }
+  return data;
+}
+
+}  // namespace
+
+static void BM_PrismCommonPrefixSearch(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  Prism& prism = *data->dict->prism();
+  vector<Prism::Match> result;
+  for (auto _ : state) {
+    for (const auto& input : data->inputs) {
+      result.clear();
+      prism.CommonPrefixSearch(input, &result);
+      benchmark::DoNotOptimize(result.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->inputs.size());
+}
+BENCHMARK(BM_PrismCommonPrefixSearch)->Arg(kSynthetic)->Arg(kLunaPinyin);
+
+// spellings at the vertices of the syllable graphs, which the syllabifier
+// looks up as it reaches them: a search for each vertex, or reading a match
+// table, which searches each vertex once.
+static void BM_PrismMatchAtVertices(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  Prism& prism = *data->dict->prism();
+  bool use_match_table = state.range(1) != 0;
+  Prism::MatchTable table;
+  for (auto _ : state) {
+    for (size_t i = 0; i < data->inputs.size(); ++i) {
+      const string& input = data->inputs[i];
+      // as the syllabifier does it, either way
+      vector<Prism::Match> matches;
+      if (use_match_table)
+        prism.CommonPrefixSearchAll(input, &table);
+      for (const auto& vertex : data->graphs[i].vertices) {
+        size_t pos = vertex.first;
+        if (pos >= input.length())
+          continue;
+        if (use_match_table) {
+          matches.assign(table.begin(pos), table.end(pos));
+          benchmark::DoNotOptimize(matches.data());
+        } else {
+          vector<Prism::Match> vertex_matches;
+          prism.CommonPrefixSearch(input.substr(pos), &vertex_matches);
+          benchmark::DoNotOptimize(vertex_matches.data());
+        }
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->inputs.size());
+}
+BENCHMARK(BM_PrismMatchAtVertices)
+    ->ArgsProduct({{kSynthetic, kLunaPinyin}, {false, true}});
+
+static void BM_PrismExpandSearch(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  Prism& prism = *data->dict->prism();
+  size_t limit = state.range(1);
+  vector<Prism::Match> result;
+  for (auto _ : state) {
+    for (const auto& input : data->inputs) {
+      // incomplete syllables
+      for (size_t length = 1; length <= 2 && length <= input.length();
+           ++length) {
+        result.clear();
+        prism.ExpandSearch(input.substr(0, length), &result, limit);
+        benchmark::DoNotOptimize(result.data());
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->inputs.size());
+}
+BENCHMARK(BM_PrismExpandSearch)
+    ->ArgsProduct({{kSynthetic, kLunaPinyin}, {64, 512}});
+
+static void BM_SyllabifierBuildSyllableGraph(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  Prism& prism = *data->dict->prism();
+  Syllabifier syllabifier("'", true);
+  for (auto _ : state) {
+    for (const auto& input : data->inputs) {
+      SyllableGraph graph;
+      benchmark::DoNotOptimize(
+          syllabifier.BuildSyllableGraph(input, prism, &graph));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->inputs.size());
+}
+BENCHMARK(BM_SyllabifierBuildSyllableGraph)
+    ->Arg(kSynthetic)
+    ->Arg(kLunaPinyin);
+
+static void BM_TableQuery(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  Table& table = *data->dict->primary_table();
+  for (auto _ : state) {
+    for (const auto& graph : data->graphs) {
+      TableQueryResult result;
+      benchmark::DoNotOptimize(table.Query(graph, 0, &result));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->graphs.size());
+}
+BENCHMARK(BM_TableQuery)->Arg(kSynthetic)->Arg(kLunaPinyin);
+
+static void BM_DictionaryLookup(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  for (auto _ : state) {
+    for (const auto& graph : data->graphs) {
+      auto collector = data->dict->Lookup(graph, 0);
+      if (collector && !collector->empty()) {
+        // the longest match, as a script translator would show first
+        benchmark::DoNotOptimize(collector->rbegin()->second.Peek());
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->graphs.size());
+}
+BENCHMARK(BM_DictionaryLookup)->Arg(kSynthetic)->Arg(kLunaPinyin);
+
+static void BM_DictionaryLookupWords(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  bool predictive = state.range(1) != 0;
+  for (auto _ : state) {
+    for (const auto& input : data->inputs) {
+      DictEntryIterator it;
+      benchmark::DoNotOptimize(data->dict->LookupWords(
+          &it, input.substr(0, predictive ? 2 : input.length()), predictive,
+          predictive ? 100 : 0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->inputs.size());
+}
+BENCHMARK(BM_DictionaryLookupWords)
+    ->ArgsProduct({{kSynthetic, kLunaPinyin}, {false, true}});
+
+static void BM_StringTableGetString(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  StringTable& string_table = *data->string_table;
+  for (auto _ : state) {
+    for (StringId string_id : data->string_ids) {
+      benchmark::DoNotOptimize(string_table.GetString(string_id));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->string_ids.size());
+}
+BENCHMARK(BM_StringTableGetString)->Arg(kSynthetic)->Arg(kLunaPinyin);
+
+static void BM_UserDictionaryLookup(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  if (!data->user_dict) {
+    state.SkipWithError("error loading user dictionary");
+    return;
+  }
+  for (auto _ : state) {
+    for (const auto& graph : data->graphs) {
+      benchmark::DoNotOptimize(
+          data->user_dict->Lookup(graph, 0, kMaxSyllablesForUserPhraseQuery));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * data->graphs.size());
+}
+BENCHMARK(BM_UserDictionaryLookup)->Arg(kSynthetic)->Arg(kLunaPinyin);
+
+static void BM_UserDictionaryUpdateEntry(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  if (!data->user_dict || data->entries.empty()) {
+    state.SkipWithError("error loading user dictionary");
+    return;
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    const auto& entry = data->entries[i++ % data->entries.size()];
+    benchmark::DoNotOptimize(data->user_dict->UpdateEntry(*entry, 1));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UserDictionaryUpdateEntry)->Arg(kSynthetic)->Arg(kLunaPinyin);
+
+static void BM_PoetMakeSentence(benchmark::State& state) {
+  DictData* data = GetDictData(state);
+  if (!data)
+    return;
+  // word graphs the way a script translator prepares them
+  vector<WordGraph> word_graphs;
+  for (const auto& graph : data->graphs) {
+    WordGraph word_graph;
+    for (const auto& x : graph.edges) {
+      auto& same_start_pos = word_graph[x.first];
+      auto collector = data->dict->Lookup(graph, x.first);
+      if (!collector)
+        continue;
+      for (auto& y : *collector) {
+        DictEntryList& homophones = same_start_pos[y.first];
+        while (homophones.size() < kMaxHomophones && !y.second.exhausted()) {
+          homophones.push_back(y.second.Peek());
+          if (!y.second.Next())
+            break;
+        }
+      }
+    }
+    word_graphs.push_back(std::move(word_graph));
+  }
+  Language language(data->dict->name());
+  Poet poet(&language, nullptr);
+  for (auto _ : state) {
+    for (size_t i = 0; i < word_graphs.size(); ++i) {
+      benchmark::DoNotOptimize(poet.MakeSentence(
+          word_graphs[i], data->graphs[i].interpreted_length, string()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * word_graphs.size());
+}
+BENCHMARK(BM_PoetMakeSentence)->Arg(kSynthetic)->Arg(kLunaPinyin);
@@ -0,0 +1,27 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <benchmark/benchmark.h>
+#include <rime_api.h>
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  RIME_STRUCT(RimeTraits, traits);
+  // put all files in the working directory ($build/bench).
+  traits.shared_data_dir = traits.user_data_dir = traits.prebuilt_data_dir =
+      traits.staging_dir = ".";
+  traits.app_name = "rime.benchmark";
+  traits.min_log_level = 2;  // ERROR
+  rime_get_api()->setup(&traits);
+  rime_get_api()->initialize(&traits);
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  rime_get_api()->finalize();
+  return 0;
+}
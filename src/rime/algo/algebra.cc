@@ -6,6 +6,8 @@
 //
 #include <algorithm>
 #include <fstream>
+#include <future>
+#include <thread>
 #include <rime/algo/algebra.h>
 #include <rime/algo/calculus.h>
 
@@ -37,6 +39,12 @@ void Script::Merge(const string& s,
   }
 }
 
+void Script::Merge(const Script& other) {
+  for (const value_type& v : other) {
+    Merge(v.first, SpellingProperties(), v.second);
+  }
+}
+
 void Script::Dump(const path& file_path) const {
   std::ofstream out(file_path.c_str());
   for (const value_type& v : *this) {
@@ -104,36 +112,111 @@ bool Projection::Apply(string* value) {
   return modified;
 }
 
+// minimum number of spellings to evaluate in a separate thread
+static const size_t kMinSpellingsPerThread = 1024;
+
+static bool apply_calculation(Calculation* x,
+                              Script::const_iterator begin,
+                              Script::const_iterator end,
+                              Script* output,
+                              bool* modified) {
+  for (auto it = begin; it != end; ++it) {
+    Spelling s(it->first);
+    bool applied = false;
+    try {
+      applied = x->Apply(&s);
+    } catch (std::runtime_error& e) {
+      LOG(ERROR) << "Error applying calculation: " << e.what();
+      return false;
+    }
+    if (applied) {
+      *modified = true;
+      if (!x->deletion()) {
+        output->Merge(it->first, SpellingProperties(), it->second);
+      }
+      if (x->addition() && !s.str.empty()) {
+        output->Merge(s.str, s.properties, it->second);
+      }
+    } else {
+      output->Merge(it->first, SpellingProperties(), it->second);
+    }
+  }
+  return true;
+}
+
+bool Projection::ApplyInParallel(Calculation* x,
+                                 const Script& input,
+                                 Script* output,
+                                 size_t num_threads,
+                                 bool* modified) {
+  // partition the script into contiguous ranges of keys
+  vector<Script::const_iterator> bounds;
+  size_t chunk_size = (input.size() + num_threads - 1) / num_threads;
+  size_t count = 0;
+  for (auto it = input.begin(); it != input.end(); ++it, ++count) {
+    if (count % chunk_size == 0)
+      bounds.push_back(it);
+  }
+  bounds.push_back(input.end());
+  size_t num_parts = bounds.size() - 1;
+  vector<Script> results(num_parts);
+  vector<char> part_modified(num_parts, false);
+  vector<std::future<bool>> workers;
+  for (size_t i = 1; i < num_parts; ++i) {
+    workers.push_back(std::async(std::launch::async, [&, i] {
+      bool m = false;
+      bool ok = apply_calculation(x, bounds[i], bounds[i + 1], &results[i], &m);
+      part_modified[i] = m;
+      return ok;
+    }));
+  }
+  bool success = true;
+  {
+    bool m = false;
+    success = apply_calculation(x, bounds[0], bounds[1], &results[0], &m);
+    part_modified[0] = m;
+  }
+  for (auto& w : workers) {
+    if (!w.get())
+      success = false;
+  }
+  if (!success)
+    return false;
+  // merge in key order so that the result is identical to serial evaluation
+  output->swap(results[0]);
+  for (size_t i = 1; i < num_parts; ++i) {
+    output->Merge(results[i]);
+  }
+  for (char m : part_modified) {
+    if (m)
+      *modified = true;
+  }
+  return true;
+}
+
 bool Projection::Apply(Script* value) {
   if (!value || value->empty())
     return false;
+  size_t num_threads = num_threads_;
+#ifdef RIME_NO_THREADING
+  num_threads = 1;
+#else
+  if (num_threads == 0) {
+    num_threads = (std::max)(1u, std::thread::hardware_concurrency());
+  }
+#endif
   bool modified = false;
   int round = 0;
   for (an<Calculation>& x : calculation_) {
     ++round;
     DLOG(INFO) << "round #" << round;
     Script temp;
-    for (const Script::value_type& v : *value) {
-      Spelling s(v.first);
-      bool applied = false;
-      try {
-        applied = x->Apply(&s);
-      } catch (std::runtime_error& e) {
-        LOG(ERROR) << "Error applying calculation: " << e.what();
-        return false;
-      }
-      if (applied) {
-        modified = true;
-        if (!x->deletion()) {
-          temp.Merge(v.first, SpellingProperties(), v.second);
-        }
-        if (x->addition() && !s.str.empty()) {
-          temp.Merge(s.str, s.properties, v.second);
-        }
-      } else {
-        temp.Merge(v.first, SpellingProperties(), v.second);
-      }
-    }
+    size_t n = (std::min)(num_threads, value->size() / kMinSpellingsPerThread);
+    bool ok = n > 1 ? ApplyInParallel(x.get(), *value, &temp, n, &modified)
+                    : apply_calculation(x.get(), value->begin(), value->end(),
+                                        &temp, &modified);
+    if (!ok)
+      return false;
     value->swap(temp);
   }
   return modified;
@@ -23,6 +23,8 @@ class Script : public map<string, vector<Spelling>> {
   void Merge(const string& s,
              const SpellingProperties& sp,
              const vector<Spelling>& v);
+  // merges spellings derived from another part of the same script
+  void Merge(const Script& other);
   void Dump(const path& file_path) const;
 };
 
@@ -34,8 +36,18 @@ class Projection {
   // {z, y, x} -> {a, b, c, d}
   RIME_DLL bool Apply(Script* value);
 
+  // evaluate each round of a large script in parallel; 0 for auto.
+  void set_num_threads(size_t num_threads) { num_threads_ = num_threads; }
+
  protected:
+  bool ApplyInParallel(Calculation* x,
+                       const Script& input,
+                       Script* output,
+                       size_t num_threads,
+                       bool* modified);
+
   vector<of<Calculation>> calculation_;
+  size_t num_threads_ = 1;
 };
 
 }  // namespace rime
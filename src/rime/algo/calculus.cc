@@ -61,15 +61,48 @@ Calculation* Transliteration::Parse(const vector<string>& args) {
   }
   if (cl == 0 && cr == 0) {
     the<Transliteration> x(new Transliteration);
+    x->ascii_only_ = true;
+    for (int i = 0; i < 128; ++i) {
+      x->ascii_map_[i] = char(i);
+    }
+    for (const auto& m : char_map) {
+      if (m.first >= 0x80 || m.second >= 0x80) {
+        x->ascii_only_ = false;
+        break;
+      }
+      x->ascii_map_[m.first] = char(m.second);
+    }
     x->char_map_.swap(char_map);
     return x.release();
   }
   return NULL;
 }
 
+bool Transliteration::ApplyAscii(Spelling* spelling) {
+  string& str(spelling->str);
+  size_t i = 0;
+  // skip the unmodified part
+  for (; i < str.length(); ++i) {
+    unsigned char c = str[i];
+    if (c < 0x80 && ascii_map_[c] != str[i])
+      break;
+  }
+  if (i == str.length())
+    return false;
+  // multi-byte characters are left intact as the mapping is ASCII only
+  for (; i < str.length(); ++i) {
+    unsigned char c = str[i];
+    if (c < 0x80)
+      str[i] = ascii_map_[c];
+  }
+  return true;
+}
+
 bool Transliteration::Apply(Spelling* spelling) {
   if (!spelling || spelling->str.empty())
     return false;
+  if (ascii_only_)
+    return ApplyAscii(spelling);
   bool modified = false;
   const char* p = spelling->str.c_str();
   const int buffer_len = 256;
@@ -81,8 +114,9 @@ bool Transliteration::Apply(Spelling* spelling) {
       modified = false;
       break;
     }
-    if (char_map_.find(c) != char_map_.end()) {
-      c = char_map_[c];
+    auto it = char_map_.find(c);
+    if (it != char_map_.end()) {
+      c = it->second;
       modified = true;
     }
     q = utf8::unchecked::append(c, q);
@@ -104,15 +138,59 @@ Calculation* Transformation::Parse(const vector<string>& args) {
   if (left.empty())
     return NULL;
   the<Transformation> x(new Transformation);
-  x->pattern_.assign(left);
-  x->replacement_.assign(right);
+  x->Assign(left, right);
   return x.release();
 }
 
+void Transformation::Assign(const string& pattern, const string& replacement) {
+  pattern_.assign(pattern);
+  replacement_.assign(replacement);
+  string literal(pattern);
+  match_begin_ = boost::starts_with(literal, "^");
+  if (match_begin_)
+    literal.erase(0, 1);
+  match_end_ = boost::ends_with(literal, "$");
+  if (match_end_)
+    literal.pop_back();
+  is_literal_ = !literal.empty() &&
+                literal.find_first_of(".[]{}()\\*+?|^$") == string::npos &&
+                replacement.find_first_of("$\\") == string::npos;
+  if (is_literal_)
+    literal_pattern_.swap(literal);
+}
+
+bool Transformation::ReplaceLiteral(const string& input, string* output) {
+  const string& x(literal_pattern_);
+  if (match_begin_ && match_end_) {
+    if (input != x)
+      return false;
+    *output = replacement_;
+  } else if (match_begin_) {
+    if (!boost::starts_with(input, x))
+      return false;
+    *output = replacement_ + input.substr(x.length());
+  } else if (match_end_) {
+    if (!boost::ends_with(input, x))
+      return false;
+    *output = input.substr(0, input.length() - x.length()) + replacement_;
+  } else {
+    if (input.find(x) == string::npos)
+      return false;
+    *output = boost::replace_all_copy(input, x, replacement_);
+  }
+  return true;
+}
+
 bool Transformation::Apply(Spelling* spelling) {
   if (!spelling || spelling->str.empty())
     return false;
-  string result = boost::regex_replace(spelling->str, pattern_, replacement_);
+  string result;
+  if (is_literal_) {
+    if (!ReplaceLiteral(spelling->str, &result))
+      return false;
+  } else {
+    result = boost::regex_replace(spelling->str, pattern_, replacement_);
+  }
   if (result == spelling->str)
     return false;
   spelling->str.swap(result);
@@ -157,30 +235,26 @@ Calculation* Derivation::Parse(const vector<string>& args) {
     // 糾錯
     if (tag == "correction") {
       the<Correction> x(new Correction);
-      x->pattern_.assign(left);
-      x->replacement_.assign(right);
+      x->Assign(left, right);
       return x.release();
     }
     // 簡拼
     if (tag == "abbrev") {
       the<Abbreviation> x(new Abbreviation);
-      x->pattern_.assign(left);
-      x->replacement_.assign(right);
+      x->Assign(left, right);
       return x.release();
     }
     // 模糊音
     if (tag == "fuzz") {
       the<Fuzzing> x(new Fuzzing);
-      x->pattern_.assign(left);
-      x->replacement_.assign(right);
+      x->Assign(left, right);
       return x.release();
     }
     // tag 無法識別, 作爲普通 derive 處理
   }
 
   the<Derivation> x(new Derivation);
-  x->pattern_.assign(left);
-  x->replacement_.assign(right);
+  x->Assign(left, right);
   return x.release();
 }
 
@@ -194,8 +268,7 @@ Calculation* Fuzzing::Parse(const vector<string>& args) {
   if (left.empty())
     return NULL;
   the<Fuzzing> x(new Fuzzing);
-  x->pattern_.assign(left);
-  x->replacement_.assign(right);
+  x->Assign(left, right);
   return x.release();
 }
 
@@ -218,8 +291,7 @@ Calculation* Abbreviation::Parse(const vector<string>& args) {
   if (left.empty())
     return NULL;
   the<Abbreviation> x(new Abbreviation);
-  x->pattern_.assign(left);
-  x->replacement_.assign(right);
+  x->Assign(left, right);
   return x.release();
 }
 
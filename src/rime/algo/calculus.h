@@ -9,6 +9,7 @@
 #define RIME_CALCULUS_H_
 
 #include <stdint.h>
+#include <array>
 #include <boost/regex.hpp>
 #include <rime_api.h>
 #include <rime/common.h>
@@ -44,7 +45,12 @@ class Transliteration : public Calculation {
   bool Apply(Spelling* spelling) override;
 
  protected:
+  bool ApplyAscii(Spelling* spelling);
+
   map<uint32_t, uint32_t> char_map_;
+  // byte-wise lookup table when the mapping is ASCII only
+  bool ascii_only_ = false;
+  std::array<char, 128> ascii_map_;
 };
 
 // xform/x/y/
@@ -54,8 +60,17 @@ class Transformation : public Calculation {
   bool Apply(Spelling* spelling) override;
 
  protected:
+  void Assign(const string& pattern, const string& replacement);
+  bool ReplaceLiteral(const string& input, string* output);
+
   boost::regex pattern_;
   string replacement_;
+  // fast path for patterns without any regex syntax, optionally anchored
+  // by ^ and/or $, and replacements without back references.
+  bool is_literal_ = false;
+  bool match_begin_ = false;
+  bool match_end_ = false;
+  string literal_pattern_;
 };
 
 // erase/x/
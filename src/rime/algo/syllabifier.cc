@@ -33,6 +33,10 @@ int Syllabifier::BuildSyllableGraph(const string& input,
   if (input.empty())
     return 0;
 
+  Prism::MatchTable prefix_matches;
+  prism.CommonPrefixSearchAll(input, &prefix_matches);
+  vector<Prism::Match> matches;
+
   size_t farthest = 0;
   VertexQueue queue;
   queue.push(Vertex{0, kNormalSpelling});  // start
@@ -63,16 +67,18 @@ int Syllabifier::BuildSyllableGraph(const string& input,
                << ", begin_pos: " << begin_pos;
 
     // see where we can go by advancing a syllable
-    vector<Prism::Match> matches;
+    if (begin_pos >= input.length())
+      continue;
+    matches.assign(prefix_matches.begin(begin_pos),
+                   prefix_matches.end(begin_pos));
     set<SyllableId> exact_match_syllables;
-    auto current_input = input.substr(begin_pos);
-    prism.CommonPrefixSearch(current_input, &matches);
     if (corrector_) {
       for (auto& m : matches) {
         exact_match_syllables.insert(m.value);
       }
       Corrections corrections;
-      corrector_->ToleranceSearch(prism, current_input, &corrections, 5);
+      corrector_->ToleranceSearch(prism, input.substr(begin_pos), &corrections,
+                                  5);
       for (const auto& m : corrections) {
         for (auto accessor = prism.QuerySpelling(m.first);
              !accessor.exhausted(); accessor.Next()) {
@@ -204,8 +210,12 @@ int Syllabifier::BuildSyllableGraph(const string& input,
   if (enable_completion_ && farthest < input.length()) {
     DLOG(INFO) << "completion enabled";
     const size_t kExpandSearchLimit = 512;
+    // the completion index yields the best keys first; a few dozen will do
+    const size_t kTopKCompletionLimit = 64;
     vector<Prism::Match> keys;
-    prism.ExpandSearch(input.substr(farthest), &keys, kExpandSearchLimit);
+    prism.TopKExpandSearch(input.substr(farthest), &keys,
+                           prism.has_completion_index() ? kTopKCompletionLimit
+                                                        : kExpandSearchLimit);
     if (!keys.empty()) {
       size_t current_pos = farthest;
       size_t end_pos = input.length();
@@ -19,8 +19,14 @@ struct ConfigResource : ConfigItemRef {
 
   ConfigResource(const string& _id, an<ConfigData> _data)
       : ConfigItemRef(nullptr), resource_id(_id), data(_data) {}
-  an<ConfigItem> GetItem() const override { return data->root; }
-  void SetItem(an<ConfigItem> item) override { data->root = item; }
+  an<ConfigItem> GetItem() const override {
+    data->LoadTree();
+    return data->root;
+  }
+  void SetItem(an<ConfigItem> item) override {
+    data->LoadTree();
+    data->root = item;
+  }
 };
 
 struct Reference {
@@ -138,10 +138,12 @@ bool Config::SetItem(const string& path, an<ConfigItem> item) {
 }
 
 an<ConfigItem> Config::GetItem() const {
+  data_->LoadTree();
   return data_->root;
 }
 
 void Config::SetItem(an<ConfigItem> item) {
+  data_->LoadTree();
   data_->root = item;
   set_modified();
 }
@@ -195,7 +197,11 @@ an<ConfigData> ConfigComponentBase::GetConfigData(const string& file_name) {
 an<ConfigData> ConfigLoader::LoadConfig(ResourceResolver* resource_resolver,
                                         const string& config_id) {
   auto data = New<ConfigData>();
-  data->LoadFromFile(resource_resolver->ResolvePath(config_id), nullptr);
+  auto file_path = resource_resolver->ResolvePath(config_id);
+  // skip parsing YAML if the deployer has compiled an image of the file
+  if (!data->LoadFromImage(file_path)) {
+    data->LoadFromFile(file_path, nullptr);
+  }
   data->set_auto_save(auto_save_);
   return data;
 }
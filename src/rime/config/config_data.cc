@@ -2,6 +2,7 @@
 // Copyright RIME Developers
 // Distributed under the BSD License
 //
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
 #include <fstream>
@@ -12,6 +13,7 @@
 #include <rime/config/config_compiler.h>
 #include <rime/config/config_cow_ref.h>
 #include <rime/config/config_data.h>
+#include <rime/config/config_image.h>
 #include <rime/config/config_types.h>
 
 namespace rime {
@@ -21,11 +23,30 @@ an<ConfigItem> ConvertFromYaml(const YAML::Node& yaml_node,
 
 void EmitYaml(an<ConfigItem> node, YAML::Emitter* emitter, int depth);
 
+ConfigData::ConfigData() = default;
+
 ConfigData::~ConfigData() {
   if (auto_save_)
     Save();
 }
 
+void ConfigData::set_modified() {
+  LoadTree();
+  modified_ = true;
+}
+
+void ConfigData::LoadTree() {
+  std::lock_guard<std::mutex> lock(image_mutex_);
+  LoadTreeFromImage();
+}
+
+void ConfigData::LoadTreeFromImage() {
+  if (image_) {
+    root = image_->root();
+    image_.reset();
+  }
+}
+
 bool ConfigData::Save() {
   return modified_ && !file_path_.empty() && SaveToFile(file_path_);
 }
@@ -35,6 +56,7 @@ bool ConfigData::LoadFromStream(std::istream& stream) {
     LOG(ERROR) << "failed to load config from stream.";
     return false;
   }
+  image_.reset();
   try {
     YAML::Node doc = YAML::Load(stream);
     root = ConvertFromYaml(doc, nullptr);
@@ -50,6 +72,7 @@ bool ConfigData::SaveToStream(std::ostream& stream) {
     LOG(ERROR) << "failed to save config to stream.";
     return false;
   }
+  LoadTree();
   try {
     YAML::Emitter emitter(stream);
     EmitYaml(root, &emitter, 0);
@@ -65,6 +88,7 @@ bool ConfigData::LoadFromFile(const path& file_path, ConfigCompiler* compiler) {
   file_path_ = file_path;
   modified_ = false;
   root.reset();
+  image_.reset();
   if (!std::filesystem::exists(file_path)) {
     if (!boost::ends_with(file_path.u8string(), ".custom.yaml"))
       LOG(WARNING) << "nonexistent config file '" << file_path << "'.";
@@ -95,6 +119,24 @@ bool ConfigData::SaveToFile(const path& file_path) {
   return SaveToStream(out);
 }
 
+bool ConfigData::LoadFromImage(const path& file_path) {
+  file_path_ = file_path;
+  modified_ = false;
+  root.reset();
+  image_.reset(new ConfigImage(ConfigImage::ImagePath(file_path)));
+  if (!image_->Load(file_path)) {
+    image_.reset();
+    return false;
+  }
+  return true;
+}
+
+bool ConfigData::SaveToImage(const path& file_path) {
+  LoadTree();
+  ConfigImage image(ConfigImage::ImagePath(file_path));
+  return image.Save(root, file_path);
+}
+
 bool ConfigData::IsListItemReference(const string& key) {
   return key.length() > 1 && key[0] == '@' && std::isalnum(key[1]);
 }
@@ -155,8 +197,14 @@ size_t ConfigData::ResolveListIndex(an<ConfigItem> item,
 class ConfigDataRootRef : public ConfigItemRef {
  public:
   ConfigDataRootRef(ConfigData* data) : ConfigItemRef(nullptr), data_(data) {}
-  an<ConfigItem> GetItem() const override { return data_->root; }
-  void SetItem(an<ConfigItem> item) override { data_->root = item; }
+  an<ConfigItem> GetItem() const override {
+    data_->LoadTree();
+    return data_->root;
+  }
+  void SetItem(an<ConfigItem> item) override {
+    data_->LoadTree();
+    data_->root = item;
+  }
 
  private:
   ConfigData* data_;
@@ -222,20 +270,15 @@ string ConfigData::JoinPath(const vector<string>& keys) {
   return boost::join(keys, "/");
 }
 
-an<ConfigItem> ConfigData::Traverse(const string& node_path) {
-  DLOG(INFO) << "traverse: " << node_path;
-  if (node_path.empty() || node_path == "/") {
-    return root;
-  }
-  vector<string> keys = SplitPath(node_path);
-  // find the YAML::Node, and wrap it!
-  an<ConfigItem> p = root;
-  for (auto it = keys.begin(), end = keys.end(); it != end; ++it) {
+static an<ConfigItem> TraverseKeys(an<ConfigItem> p,
+                                   vector<string>::const_iterator it,
+                                   vector<string>::const_iterator end) {
+  for (; it != end; ++it) {
     ConfigItem::ValueType node_type = ConfigItem::kMap;
     size_t list_index = 0;
-    if (IsListItemReference(*it)) {
+    if (ConfigData::IsListItemReference(*it)) {
       node_type = ConfigItem::kList;
-      list_index = ResolveListIndex(p, *it, true);
+      list_index = ConfigData::ResolveListIndex(p, *it, true);
     }
     if (!p || p->type() != node_type) {
       return nullptr;
@@ -249,6 +292,50 @@ an<ConfigItem> ConfigData::Traverse(const string& node_path) {
   return p;
 }
 
+an<ConfigItem> ConfigData::Traverse(const string& node_path) {
+  DLOG(INFO) << "traverse: " << node_path;
+  if (node_path.empty() || node_path == "/") {
+    LoadTree();
+    return root;
+  }
+  vector<string> keys = SplitPath(node_path);
+  {
+    std::lock_guard<std::mutex> lock(image_mutex_);
+    if (image_) {
+      return TraverseImage(node_path, keys);
+    }
+  }
+  // find the YAML::Node, and wrap it!
+  return TraverseKeys(root, keys.begin(), keys.end());
+}
+
+an<ConfigItem> ConfigData::TraverseImage(const string& node_path,
+                                         const vector<string>& keys) {
+  // start from the longest indexed prefix of the path, which ends where the
+  // path does or before a separator.
+  size_t start = (std::min)(node_path.find_first_not_of('/'),
+                            node_path.length());
+  size_t end = node_path.length();
+  for (size_t n = keys.size(); n > 0; --n) {
+    uint32_t node_index = 0;
+    if (image_->Find(node_path.c_str() + start, end - start, &node_index)) {
+      size_t depth = 0;
+      auto item = image_->GetItem(node_index, &depth);
+      return TraverseKeys(item, keys.begin() + (n - depth), keys.end());
+    }
+    if (n > 1)
+      end = node_path.rfind('/', end - 1);
+  }
+  // every key of a map is indexed, so only relative references to the items
+  // of a root list are left to resolve
+  if (image_->root_type() != ConfigItem::kList ||
+      !IsListItemReference(keys.front())) {
+    return nullptr;
+  }
+  LoadTreeFromImage();
+  return TraverseKeys(root, keys.begin(), keys.end());
+}
+
 an<ConfigItem> ConvertFromYaml(const YAML::Node& node,
                                ConfigCompiler* compiler) {
   if (YAML::NodeType::Null == node.Type()) {
@@ -7,16 +7,18 @@
 #define RIME_CONFIG_DATA_H_
 
 #include <iostream>
+#include <mutex>
 #include <rime/common.h>
 
 namespace rime {
 
 class ConfigCompiler;
+class ConfigImage;
 class ConfigItem;
 
 class ConfigData {
  public:
-  ConfigData() = default;
+  ConfigData();
   ~ConfigData();
 
   // returns whether actually saved to file.
@@ -25,8 +27,15 @@ class ConfigData {
   bool SaveToStream(std::ostream& stream);
   bool LoadFromFile(const path& file_path, ConfigCompiler* compiler);
   bool SaveToFile(const path& file_path);
+  // the compiled image is preferred to the YAML file if it is up to date.
+  bool LoadFromImage(const path& file_path);
+  bool SaveToImage(const path& file_path);
   bool TraverseWrite(const string& path, an<ConfigItem> item);
   an<ConfigItem> Traverse(const string& path);
+  // items in an image are created as they are looked up; this creates the
+  // rest of the tree, which is required before accessing root directly.
+  // lookups may come from any thread, so both are done under a lock.
+  void LoadTree();
 
   static vector<string> SplitPath(const string& path);
   static string JoinPath(const vector<string>& keys);
@@ -38,15 +47,23 @@ class ConfigData {
 
   const path& file_path() const { return file_path_; }
   bool modified() const { return modified_; }
-  void set_modified() { modified_ = true; }
+  void set_modified();
   void set_auto_save(bool auto_save) { auto_save_ = auto_save; }
 
   an<ConfigItem> root;
 
  protected:
+  // these expect image_mutex_ to be held.
+  an<ConfigItem> TraverseImage(const string& node_path,
+                               const vector<string>& keys);
+  void LoadTreeFromImage();
+
   path file_path_;
   bool modified_ = false;
   bool auto_save_ = false;
+  // the image the tree is being loaded from, until root is accessed
+  the<ConfigImage> image_;
+  std::mutex image_mutex_;
 };
 
 }  // namespace rime
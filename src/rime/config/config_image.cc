@@ -0,0 +1,415 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <rime/config/config_data.h>
+#include <rime/config/config_image.h>
+#include <rime/config/config_types.h>
+
+namespace rime {
+
+using namespace config_image;
+
+static const char kConfigImageFormat[] = "Rime::ConfigImage/1.0";
+
+class ConfigImageRegion {
+ public:
+  explicit ConfigImageRegion(const path& file_path)
+      : file_(file_path.c_str(), boost::interprocess::read_only),
+        region_(file_, boost::interprocess::read_only) {}
+  const char* address() const {
+    return static_cast<const char*>(region_.get_address());
+  }
+  size_t size() const { return region_.get_size(); }
+
+ private:
+  boost::interprocess::file_mapping file_;
+  boost::interprocess::mapped_region region_;
+};
+
+static bool get_source_file_stat(const path& source_path,
+                                 uint64_t* size,
+                                 int64_t* mtime) {
+  std::error_code ec;
+  *size = std::filesystem::file_size(source_path, ec);
+  if (ec)
+    return false;
+  auto last_write_time = std::filesystem::last_write_time(source_path, ec);
+  if (ec)
+    return false;
+  *mtime = last_write_time.time_since_epoch().count();
+  return true;
+}
+
+namespace {
+
+class ConfigImageBuilder {
+ public:
+  void AddNode(an<ConfigItem> item, const string& node_path, bool indexed);
+  string Serialize(uint64_t source_size, int64_t source_mtime);
+
+ private:
+  StringRef AddString(const string& str);
+
+  vector<Node> nodes_;
+  vector<MapEntry> map_entries_;
+  vector<ListEntry> list_entries_;
+  vector<PathEntry> paths_;
+  vector<string> path_strings_;
+  string string_pool_;
+};
+
+StringRef ConfigImageBuilder::AddString(const string& str) {
+  StringRef ref{uint32_t(string_pool_.length()), uint32_t(str.length())};
+  string_pool_ += str;
+  return ref;
+}
+
+// children are always added after their parent, which makes the image
+// free of cycles by construction.
+void ConfigImageBuilder::AddNode(an<ConfigItem> item,
+                                 const string& node_path,
+                                 bool indexed) {
+  uint32_t index = nodes_.size();
+  nodes_.push_back({ConfigItem::kNull, 0, 0});
+  if (indexed && !node_path.empty()) {
+    paths_.push_back({{0, 0}, index});
+    path_strings_.push_back(node_path);
+  }
+  if (!item)
+    return;
+  // null items are dropped as they are when emitting YAML
+  if (auto value = As<ConfigValue>(item)) {
+    StringRef ref = AddString(value->str());
+    nodes_[index] = {ConfigItem::kScalar, ref.offset, ref.length};
+  } else if (auto list = As<ConfigList>(item)) {
+    vector<an<ConfigItem>> elements;
+    for (auto it = list->begin(); it != list->end(); ++it) {
+      if (*it && (*it)->type() != ConfigItem::kNull)
+        elements.push_back(*it);
+    }
+    uint32_t begin = list_entries_.size();
+    nodes_[index] = {ConfigItem::kList, begin, uint32_t(elements.size())};
+    list_entries_.resize(begin + elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+      list_entries_[begin + i] = nodes_.size();
+      string child_path = (node_path.empty() ? "" : node_path + "/") +
+                          ConfigData::FormatListIndex(i);
+      AddNode(elements[i], child_path, indexed);
+    }
+  } else if (auto map = As<ConfigMap>(item)) {
+    vector<pair<string, an<ConfigItem>>> entries;
+    for (auto it = map->begin(); it != map->end(); ++it) {
+      if (it->second && it->second->type() != ConfigItem::kNull)
+        entries.push_back(*it);
+    }
+    uint32_t begin = map_entries_.size();
+    nodes_[index] = {ConfigItem::kMap, begin, uint32_t(entries.size())};
+    map_entries_.resize(begin + entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const string& key = entries[i].first;
+      map_entries_[begin + i] = {AddString(key), uint32_t(nodes_.size())};
+      // such keys cannot be reached by the path syntax
+      bool key_indexed = indexed && key.find('/') == string::npos &&
+                         !ConfigData::IsListItemReference(key);
+      string child_path = node_path.empty() ? key : node_path + "/" + key;
+      AddNode(entries[i].second, child_path, key_indexed);
+    }
+  }
+}
+
+template <class T>
+static void append_table(string* buffer, const vector<T>& table) {
+  if (!table.empty()) {
+    buffer->append(reinterpret_cast<const char*>(table.data()),
+                   sizeof(T) * table.size());
+  }
+}
+
+string ConfigImageBuilder::Serialize(uint64_t source_size,
+                                     int64_t source_mtime) {
+  vector<size_t> order(paths_.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return path_strings_[a] < path_strings_[b];
+  });
+  vector<PathEntry> sorted_paths;
+  sorted_paths.reserve(paths_.size());
+  for (size_t i : order) {
+    sorted_paths.push_back({AddString(path_strings_[i]), paths_[i].node});
+  }
+  Metadata metadata;
+  std::memset(&metadata, 0, sizeof(metadata));
+  std::strncpy(metadata.format, kConfigImageFormat,
+               Metadata::kFormatMaxLength - 1);
+  metadata.source_size = source_size;
+  metadata.source_mtime = source_mtime;
+  metadata.num_nodes = nodes_.size();
+  metadata.num_map_entries = map_entries_.size();
+  metadata.num_list_entries = list_entries_.size();
+  metadata.num_paths = sorted_paths.size();
+  metadata.string_pool_size = string_pool_.size();
+  string buffer(reinterpret_cast<const char*>(&metadata), sizeof(metadata));
+  append_table(&buffer, nodes_);
+  append_table(&buffer, map_entries_);
+  append_table(&buffer, list_entries_);
+  append_table(&buffer, sorted_paths);
+  buffer += string_pool_;
+  return buffer;
+}
+
+}  // namespace
+
+ConfigImage::ConfigImage(const path& file_path) : file_path_(file_path) {}
+
+ConfigImage::~ConfigImage() {
+  Close();
+}
+
+path ConfigImage::ImagePath(const path& config_path) {
+  return path(config_path).replace_extension(".bin");
+}
+
+bool ConfigImage::Save(an<ConfigItem> root, const path& source_path) {
+  uint64_t source_size = 0;
+  int64_t source_mtime = 0;
+  if (!get_source_file_stat(source_path, &source_size, &source_mtime)) {
+    LOG(ERROR) << "source file of config image not found: " << source_path;
+    return false;
+  }
+  LOG(INFO) << "saving config image '" << file_path_ << "'.";
+  ConfigImageBuilder builder;
+  builder.AddNode(root, "", true);
+  string buffer = builder.Serialize(source_size, source_mtime);
+  // write to a temporary file first, lest readers see a partial file
+  path temp_path(file_path_);
+  temp_path += ".tmp";
+  {
+    std::ofstream fout(temp_path.c_str(), std::ios::binary);
+    fout.write(buffer.data(), buffer.length());
+    if (!fout) {
+      LOG(ERROR) << "error writing file: " << temp_path;
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, file_path_, ec);
+  if (ec) {
+    LOG(ERROR) << "error renaming " << temp_path << ": " << ec.message();
+    return false;
+  }
+  return true;
+}
+
+bool ConfigImage::Load(const path& source_path) {
+  Close();
+  std::error_code ec;
+  if (!std::filesystem::exists(file_path_, ec))
+    return false;
+  uint64_t source_size = 0;
+  int64_t source_mtime = 0;
+  if (!get_source_file_stat(source_path, &source_size, &source_mtime))
+    return false;
+  try {
+    region_.reset(new ConfigImageRegion(file_path_));
+  } catch (const boost::interprocess::interprocess_exception& e) {
+    LOG(ERROR) << "error mapping config image '" << file_path_
+               << "': " << e.what();
+    return false;
+  }
+  if (!Validate(region_->size())) {
+    LOG(ERROR) << "invalid config image '" << file_path_ << "'.";
+    Close();
+    return false;
+  }
+  if (metadata_->source_size != source_size ||
+      metadata_->source_mtime != source_mtime) {
+    LOG(INFO) << "config image '" << file_path_ << "' is out of date.";
+    Close();
+    return false;
+  }
+  LOG(INFO) << "loading config image '" << file_path_ << "'.";
+  return true;
+}
+
+void ConfigImage::Close() {
+  items_.clear();
+  parents_.clear();
+  metadata_ = nullptr;
+  nodes_ = nullptr;
+  map_entries_ = nullptr;
+  list_entries_ = nullptr;
+  paths_ = nullptr;
+  string_pool_ = nullptr;
+  region_.reset();
+}
+
+bool ConfigImage::Validate(size_t file_size) {
+  const char* base = region_->address();
+  if (file_size < sizeof(Metadata))
+    return false;
+  metadata_ = reinterpret_cast<const Metadata*>(base);
+  if (std::strncmp(metadata_->format, kConfigImageFormat,
+                   Metadata::kFormatMaxLength)) {
+    return false;
+  }
+  uint64_t num_nodes = metadata_->num_nodes;
+  uint64_t expected_size = sizeof(Metadata) + sizeof(Node) * num_nodes +
+                           sizeof(MapEntry) * metadata_->num_map_entries +
+                           sizeof(ListEntry) * metadata_->num_list_entries +
+                           sizeof(PathEntry) * metadata_->num_paths +
+                           metadata_->string_pool_size;
+  if (num_nodes == 0 || expected_size != file_size)
+    return false;
+  const char* p = base + sizeof(Metadata);
+  nodes_ = reinterpret_cast<const Node*>(p);
+  p += sizeof(Node) * num_nodes;
+  map_entries_ = reinterpret_cast<const MapEntry*>(p);
+  p += sizeof(MapEntry) * metadata_->num_map_entries;
+  list_entries_ = reinterpret_cast<const ListEntry*>(p);
+  p += sizeof(ListEntry) * metadata_->num_list_entries;
+  paths_ = reinterpret_cast<const PathEntry*>(p);
+  p += sizeof(PathEntry) * metadata_->num_paths;
+  string_pool_ = p;
+  auto valid_string = [this](const StringRef& ref) {
+    return uint64_t(ref.offset) + ref.length <= metadata_->string_pool_size;
+  };
+  // every node but the root has exactly one parent, which comes before it
+  parents_.assign(num_nodes, 0);
+  auto set_parent = [this](uint32_t child, uint32_t parent) {
+    if (parents_[child] != 0)
+      return false;
+    parents_[child] = parent;
+    return true;
+  };
+  for (uint32_t i = 0; i < num_nodes; ++i) {
+    const Node& node = nodes_[i];
+    if (node.type == ConfigItem::kScalar) {
+      if (!valid_string({node.begin, node.size}))
+        return false;
+    } else if (node.type == ConfigItem::kList) {
+      if (uint64_t(node.begin) + node.size > metadata_->num_list_entries)
+        return false;
+      for (uint32_t j = 0; j < node.size; ++j) {
+        ListEntry child = list_entries_[node.begin + j];
+        if (child <= i || child >= num_nodes || !set_parent(child, i))
+          return false;
+      }
+    } else if (node.type == ConfigItem::kMap) {
+      if (uint64_t(node.begin) + node.size > metadata_->num_map_entries)
+        return false;
+      for (uint32_t j = 0; j < node.size; ++j) {
+        const MapEntry& entry = map_entries_[node.begin + j];
+        if (!valid_string(entry.key) || entry.node <= i ||
+            entry.node >= num_nodes || !set_parent(entry.node, i))
+          return false;
+      }
+    } else if (node.type != ConfigItem::kNull) {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < metadata_->num_paths; ++i) {
+    if (!valid_string(paths_[i].path) || paths_[i].node >= num_nodes)
+      return false;
+  }
+  return true;
+}
+
+string ConfigImage::GetString(const StringRef& ref) const {
+  return string(string_pool_ + ref.offset, ref.length);
+}
+
+an<ConfigItem> ConfigImage::CreateItem(uint32_t node_index) {
+  auto found = items_.find(node_index);
+  if (found != items_.end())
+    return found->second;
+  const Node& node = nodes_[node_index];
+  if (node.type == ConfigItem::kScalar) {
+    return New<ConfigValue>(GetString({node.begin, node.size}));
+  } else if (node.type == ConfigItem::kList) {
+    auto list = New<ConfigList>();
+    list->Resize(node.size);
+    for (uint32_t j = 0; j < node.size; ++j) {
+      list->SetAt(j, CreateItem(list_entries_[node.begin + j]));
+    }
+    return list;
+  } else if (node.type == ConfigItem::kMap) {
+    auto map = New<ConfigMap>();
+    for (uint32_t j = 0; j < node.size; ++j) {
+      const MapEntry& entry = map_entries_[node.begin + j];
+      map->Set(GetString(entry.key), CreateItem(entry.node));
+    }
+    return map;
+  }
+  return nullptr;
+}
+
+an<ConfigItem> ConfigImage::root() {
+  if (!nodes_)
+    return nullptr;
+  size_t depth = 0;
+  return GetItem(0, &depth);
+}
+
+ConfigItem::ValueType ConfigImage::root_type() const {
+  return nodes_ ? ConfigItem::ValueType(nodes_[0].type) : ConfigItem::kNull;
+}
+
+bool ConfigImage::Find(const string& node_path, uint32_t* node_index) const {
+  size_t start = node_path.find_first_not_of('/');
+  if (start == string::npos)
+    return false;
+  return Find(node_path.c_str() + start, node_path.length() - start,
+              node_index);
+}
+
+bool ConfigImage::Find(const char* key,
+                       size_t key_length,
+                       uint32_t* node_index) const {
+  if (!paths_ || key_length == 0)
+    return false;
+  auto begin = paths_;
+  auto end = paths_ + metadata_->num_paths;
+  auto it = std::lower_bound(
+      begin, end, key_length, [&](const PathEntry& entry, size_t) {
+        const char* s = string_pool_ + entry.path.offset;
+        int cmp = std::memcmp(s, key, (std::min)(size_t(entry.path.length),
+                                                  key_length));
+        return cmp < 0 || (cmp == 0 && entry.path.length < key_length);
+      });
+  if (it == end || it->path.length != key_length ||
+      std::memcmp(string_pool_ + it->path.offset, key, key_length) != 0)
+    return false;
+  *node_index = it->node;
+  return true;
+}
+
+an<ConfigItem> ConfigImage::GetItem(uint32_t node_index, size_t* depth) {
+  // the topmost item handed out decides what is below it now
+  auto top = items_.end();
+  size_t levels = 0;
+  for (uint32_t i = node_index;; i = parents_[i], ++levels) {
+    auto found = items_.find(i);
+    if (found != items_.end()) {
+      top = found;
+      *depth = levels;
+    }
+    if (i == 0)
+      break;
+  }
+  if (top != items_.end())
+    return top->second;
+  *depth = 0;
+  auto item = CreateItem(node_index);
+  items_[node_index] = item;
+  return item;
+}
+
+}  // namespace rime
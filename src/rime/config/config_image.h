@@ -0,0 +1,112 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#ifndef RIME_CONFIG_IMAGE_H_
+#define RIME_CONFIG_IMAGE_H_
+
+#include <stdint.h>
+#include <rime/common.h>
+#include <rime/config/config_types.h>
+
+namespace rime {
+
+namespace config_image {
+
+struct Metadata {
+  static const int kFormatMaxLength = 32;
+  char format[kFormatMaxLength];
+  // the YAML file this image was made from; the image is stale if it changes
+  uint64_t source_size;
+  int64_t source_mtime;
+  // tables, in units of their own element size, following the metadata
+  uint32_t num_nodes;
+  uint32_t num_map_entries;
+  uint32_t num_list_entries;
+  uint32_t num_paths;
+  uint32_t string_pool_size;
+};
+
+struct Node {
+  // ConfigItem::ValueType
+  uint32_t type;
+  // scalar: offset in string pool; list / map: index of the first entry
+  uint32_t begin;
+  // scalar: string length; list / map: number of entries
+  uint32_t size;
+};
+
+struct StringRef {
+  uint32_t offset;
+  uint32_t length;
+};
+
+struct MapEntry {
+  StringRef key;
+  uint32_t node;
+};
+
+using ListEntry = uint32_t;
+
+// sorted by path, for binary search
+struct PathEntry {
+  StringRef path;
+  uint32_t node;
+};
+
+}  // namespace config_image
+
+class ConfigImageRegion;
+
+// A compiled config tree, which can be memory-mapped instead of parsing YAML.
+// Every node reachable by a "path/to/node" is indexed by its path.
+// Config items are created on demand, as the nodes are looked up.
+class ConfigImage {
+ public:
+  explicit ConfigImage(const path& file_path);
+  ~ConfigImage();
+
+  // the image file that accompanies a config file.
+  static path ImagePath(const path& config_path);
+
+  bool Save(an<ConfigItem> root, const path& source_path);
+  // fails if the image is missing, damaged or older than the source file
+  bool Load(const path& source_path);
+  void Close();
+
+  // creates the whole tree, reusing items that have been handed out.
+  an<ConfigItem> root();
+  ConfigItem::ValueType root_type() const;
+  // returns false if the path is not indexed; then walk the tree instead.
+  bool Find(const string& node_path, uint32_t* node_index) const;
+  // the same, for a path of the given length without leading separators.
+  bool Find(const char* key, size_t key_length, uint32_t* node_index) const;
+  // returns the item of a node. once handed out, an item can be modified
+  // by its owner; so if an ancestor of the node has been handed out, returns
+  // that instead, and *depth is the number of keys to walk down from there.
+  an<ConfigItem> GetItem(uint32_t node_index, size_t* depth);
+
+  const path& file_path() const { return file_path_; }
+
+ private:
+  bool Validate(size_t file_size);
+  an<ConfigItem> CreateItem(uint32_t node_index);
+  string GetString(const config_image::StringRef& ref) const;
+
+  path file_path_;
+  the<ConfigImageRegion> region_;
+  const config_image::Metadata* metadata_ = nullptr;
+  const config_image::Node* nodes_ = nullptr;
+  const config_image::MapEntry* map_entries_ = nullptr;
+  const config_image::ListEntry* list_entries_ = nullptr;
+  const config_image::PathEntry* paths_ = nullptr;
+  const char* string_pool_ = nullptr;
+  // parent of each node; the root is its own parent
+  vector<uint32_t> parents_;
+  // config items handed out, by node
+  map<uint32_t, an<ConfigItem>> items_;
+};
+
+}  // namespace rime
+
+#endif  // RIME_CONFIG_IMAGE_H_
@@ -26,7 +26,14 @@ bool SaveOutputPlugin::ReviewCompileOutput(ConfigCompiler* compiler,
 bool SaveOutputPlugin::ReviewLinkOutput(ConfigCompiler* compiler,
                                         an<ConfigResource> resource) {
   auto file_path = resource_resolver_->ResolvePath(resource->resource_id);
-  return resource->data->SaveToFile(file_path);
+  if (!resource->data->SaveToFile(file_path))
+    return false;
+  // the image is optional; loaders fall back to the YAML file without it
+  if (!resource->data->SaveToImage(file_path)) {
+    LOG(WARNING) << "failed to save config image for "
+                 << resource->resource_id;
+  }
+  return true;
 }
 
 }  // namespace rime
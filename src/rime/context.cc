@@ -5,6 +5,7 @@
 // 2011-05-08 GONG Chen <chen.sst@gmail.com>
 //
 #include <algorithm>
+#include <atomic>
 #include <utility>
 #include <rime/candidate.h>
 #include <rime/context.h>
@@ -15,7 +16,10 @@ namespace rime {
 
 const string kSelectedBeforeEditing = "selected_before_editing";
 
+static std::atomic<uint64_t> g_last_generation{0};
+
 bool Context::Commit() {
+  ApplyPendingUpdate();
   if (!IsComposing())
     return false;
   // notify the engine and interesting components
@@ -26,12 +30,14 @@ bool Context::Commit() {
 }
 
 string Context::GetCommitText() const {
+  ApplyPendingUpdate();
   if (get_option("dumb"))
     return string();
   return composition_.GetCommitText();
 }
 
 string Context::GetScriptText() const {
+  ApplyPendingUpdate();
   return composition_.GetScriptText();
 }
 
@@ -42,14 +48,19 @@ string Context::GetSoftCursor() const {
 }
 
 Preedit Context::GetPreedit() const {
+  ApplyPendingUpdate();
   return composition_.GetPreedit(input_, caret_pos_, GetSoftCursor());
 }
 
 bool Context::IsComposing() const {
-  return !input_.empty() || !composition_.empty();
+  if (!input_.empty())
+    return true;
+  ApplyPendingUpdate();
+  return !composition_.empty();
 }
 
 bool Context::HasMenu() const {
+  ApplyPendingUpdate();
   if (composition_.empty())
     return false;
   const auto& menu(composition_.back().menu);
@@ -57,6 +68,7 @@ bool Context::HasMenu() const {
 }
 
 an<Candidate> Context::GetSelectedCandidate() const {
+  ApplyPendingUpdate();
   if (composition_.empty())
     return nullptr;
   return composition_.back().GetSelectedCandidate();
@@ -70,7 +82,7 @@ bool Context::PushInput(char ch) {
     input_.insert(caret_pos_, 1, ch);
     ++caret_pos_;
   }
-  update_notifier_(this);
+  NotifyUpdate();
   return true;
 }
 
@@ -82,7 +94,7 @@ bool Context::PushInput(const string& str) {
     input_.insert(caret_pos_, str);
     caret_pos_ += str.length();
   }
-  update_notifier_(this);
+  NotifyUpdate();
   return true;
 }
 
@@ -91,7 +103,7 @@ bool Context::PopInput(size_t len) {
     return false;
   caret_pos_ -= len;
   input_.erase(caret_pos_, len);
-  update_notifier_(this);
+  NotifyUpdate();
   return true;
 }
 
@@ -99,7 +111,7 @@ bool Context::DeleteInput(size_t len) {
   if (caret_pos_ + len > input_.length())
     return false;
   input_.erase(caret_pos_, len);
-  update_notifier_(this);
+  NotifyUpdate();
   return true;
 }
 
@@ -107,7 +119,7 @@ void Context::Clear() {
   input_.clear();
   caret_pos_ = 0;
   composition_.clear();
-  update_notifier_(this);
+  NotifyUpdate();
 }
 
 void Context::AbortComposition() {
@@ -116,12 +128,14 @@ void Context::AbortComposition() {
 }
 
 bool Context::Select(size_t index) {
+  ApplyPendingUpdate();
   if (composition_.empty())
     return false;
   Segment& seg(composition_.back());
   if (auto cand = seg.GetCandidateAt(index)) {
     seg.selected_index = index;
     seg.status = Segment::kSelected;
+    changed_ = true;
     DLOG(INFO) << "Selected: '" << cand->text() << "', index = " << index;
     select_notifier_(this);
     return true;
@@ -130,6 +144,7 @@ bool Context::Select(size_t index) {
 }
 
 bool Context::Highlight(size_t index) {
+  ApplyPendingUpdate();
   if (composition_.empty() || !composition_.back().menu)
     return false;
   Segment& seg(composition_.back());
@@ -142,23 +157,26 @@ bool Context::Highlight(size_t index) {
     return false;
   }
   seg.selected_index = new_index;
-  update_notifier_(this);
+  NotifyUpdate();
   DLOG(INFO) << "selection changed from: " << previous_index
              << " to: " << new_index;
   return true;
 }
 
 bool Context::DeleteCandidate(size_t index) {
+  ApplyPendingUpdate();
   if (composition_.empty())
     return false;
   Segment& seg(composition_.back());
   seg.selected_index = index;
+  changed_ = true;
   DLOG(INFO) << "Deleting candidate: " << seg.GetSelectedCandidate()->text();
   delete_notifier_(this);
   return true;  // CAVEAT: this doesn't mean anything is deleted for sure
 }
 
 bool Context::DeleteCurrentSelection() {
+  ApplyPendingUpdate();
   if (composition_.empty())
     return false;
   Segment& seg(composition_.back());
@@ -166,10 +184,12 @@ bool Context::DeleteCurrentSelection() {
 }
 
 bool Context::ConfirmCurrentSelection() {
+  ApplyPendingUpdate();
   if (composition_.empty())
     return false;
   Segment& seg(composition_.back());
   seg.status = Segment::kSelected;
+  changed_ = true;
   if (auto cand = seg.GetSelectedCandidate()) {
     DLOG(INFO) << "Confirmed: '" << cand->text()
                << "', selected_index = " << seg.selected_index;
@@ -184,6 +204,8 @@ bool Context::ConfirmCurrentSelection() {
   return true;
 }
 
+// confirmed segments are kept in recomposition, so this does not wait for a
+// pending update.
 void Context::BeginEditing() {
   for (auto it = composition_.rbegin(); it != composition_.rend(); ++it) {
     if (it->status > Segment::kSelected) {
@@ -202,18 +224,20 @@ bool Context::ConfirmPreviousSelection() {
 }
 
 bool Context::ReopenPreviousSegment() {
+  ApplyPendingUpdate();
   if (composition_.Trim()) {
     if (!composition_.empty() &&
         composition_.back().status >= Segment::kSelected) {
       composition_.back().Reopen(caret_pos());
     }
-    update_notifier_(this);
+    NotifyUpdate();
     return true;
   }
   return false;
 }
 
 bool Context::ClearPreviousSegment() {
+  ApplyPendingUpdate();
   if (composition_.empty())
     return false;
   size_t where = composition_.back().start;
@@ -224,6 +248,7 @@ bool Context::ClearPreviousSegment() {
 }
 
 bool Context::ReopenPreviousSelection() {
+  ApplyPendingUpdate();
   for (auto it = composition_.rbegin(); it != composition_.rend(); ++it) {
     if (it->status > Segment::kSelected)
       return false;
@@ -236,7 +261,7 @@ bool Context::ReopenPreviousSelection() {
         composition_.pop_back();
       }
       it->Reopen(caret_pos());
-      update_notifier_(this);
+      NotifyUpdate();
       return true;
     }
   }
@@ -244,6 +269,7 @@ bool Context::ReopenPreviousSelection() {
 }
 
 bool Context::ClearNonConfirmedComposition() {
+  ApplyPendingUpdate();
   bool reverted = false;
   while (!composition_.empty() &&
          composition_.back().status < Segment::kSelected) {
@@ -251,6 +277,7 @@ bool Context::ClearNonConfirmedComposition() {
     reverted = true;
   }
   if (reverted) {
+    changed_ = true;
     composition_.Forward();
     DLOG(INFO) << "composition: " << composition_.GetDebugText();
   }
@@ -259,32 +286,80 @@ bool Context::ClearNonConfirmedComposition() {
 
 bool Context::RefreshNonConfirmedComposition() {
   if (ClearNonConfirmedComposition()) {
-    update_notifier_(this);
+    NotifyUpdate();
     return true;
   }
   return false;
 }
 
+void Context::NotifyUpdate() {
+  changed_ = true;
+  if (batch_depth_ > 0) {
+    update_pending_ = true;
+    return;
+  }
+  update_notifier_(this);
+}
+
+void Context::ApplyPendingUpdate() const {
+  if (!update_pending_)
+    return;
+  update_pending_ = false;
+  // the composition is derived from input, although the notifier is not const.
+  auto* self = const_cast<Context*>(this);
+  self->update_notifier_(self);
+}
+
+uint64_t Context::generation() const {
+  // the menu may grow on a worker thread without the context knowing.
+  uint64_t menu_version = 0;
+  if (!composition_.empty() && composition_.back().menu) {
+    menu_version = composition_.back().menu->version();
+  }
+  if (menu_version != menu_version_) {
+    menu_version_ = menu_version;
+    changed_ = true;
+  }
+  // a new number is drawn only when asked for after changes.
+  if (changed_) {
+    generation_ = ++g_last_generation;
+    changed_ = false;
+  }
+  return generation_;
+}
+
+void Context::BeginBatch() {
+  ++batch_depth_;
+}
+
+void Context::EndBatch() {
+  if (batch_depth_ == 0 || --batch_depth_ > 0)
+    return;
+  ApplyPendingUpdate();
+}
+
 void Context::set_caret_pos(size_t caret_pos) {
   if (caret_pos > input_.length())
     caret_pos_ = input_.length();
   else
     caret_pos_ = caret_pos;
-  update_notifier_(this);
+  NotifyUpdate();
 }
 
 void Context::set_composition(Composition&& comp) {
   composition_ = std::move(comp);
+  changed_ = true;
 }
 
 void Context::set_input(const string& value) {
   input_ = value;
   caret_pos_ = input_.length();
-  update_notifier_(this);
+  NotifyUpdate();
 }
 
 void Context::set_option(const string& name, bool value) {
   options_[name] = value;
+  changed_ = true;
   DLOG(INFO) << "Context::set_option " << name << " = " << value;
   option_update_notifier_(this, name);
 }
@@ -7,6 +7,7 @@
 #ifndef RIME_CONTEXT_H_
 #define RIME_CONTEXT_H_
 
+#include <stdint.h>
 #include <rime/common.h>
 #include <rime/commit_history.h>
 #include <rime/composition.h>
@@ -67,8 +68,15 @@ class RIME_DLL Context {
   size_t caret_pos() const { return caret_pos_; }
 
   void set_composition(Composition&& comp);
-  Composition& composition() { return composition_; }
-  const Composition& composition() const { return composition_; }
+  // callers editing the composition in place should call MarkChanged().
+  Composition& composition() {
+    ApplyPendingUpdate();
+    return composition_;
+  }
+  const Composition& composition() const {
+    ApplyPendingUpdate();
+    return composition_;
+  }
   CommitHistory& commit_history() { return commit_history_; }
   const CommitHistory& commit_history() const { return commit_history_; }
 
@@ -95,8 +103,23 @@ class RIME_DLL Context {
   }
   KeyEventNotifier& unhandled_key_notifier() { return unhandled_key_notifier_; }
 
+  // Update notifications are deferred within a batch of edits, eg. keys
+  // delivered in a burst; then the composition is updated once, when the
+  // batch ends or when it is accessed. Batches can be nested.
+  void BeginBatch();
+  void EndBatch();
+  bool in_batch() const { return batch_depth_ > 0; }
+
+  // A number that changes whenever the context may have changed, for clients
+  // to skip retrieving a context they already have. Unique across contexts.
+  // Candidates added to the current menu in the background count as changes.
+  uint64_t generation() const;
+  void MarkChanged() { changed_ = true; }
+
  private:
   string GetSoftCursor() const;
+  void NotifyUpdate();
+  void ApplyPendingUpdate() const;
 
   string input_;
   size_t caret_pos_ = 0;
@@ -104,6 +127,11 @@ class RIME_DLL Context {
   CommitHistory commit_history_;
   map<string, bool> options_;
   map<string, string> properties_;
+  int batch_depth_ = 0;
+  mutable bool update_pending_ = false;
+  mutable bool changed_ = true;
+  mutable uint64_t generation_ = 0;
+  mutable uint64_t menu_version_ = 0;
 
   Notifier commit_notifier_;
   Notifier select_notifier_;
@@ -16,55 +16,90 @@
 using namespace rime;
 using namespace corrector;
 
-static hash_map<char, hash_set<char>> keyboard_map = {
-    {'1', {'2', 'q', 'w'}},
-    {'2', {'1', '3', 'q', 'w', 'e'}},
-    {'3', {'2', '4', 'w', 'e', 'r'}},
-    {'4', {'3', '5', 'e', 'r', 't'}},
-    {'5', {'4', '6', 'r', 't', 'y'}},
-    {'6', {'5', '7', 't', 'y', 'u'}},
-    {'7', {'6', '8', 'y', 'u', 'i'}},
-    {'8', {'7', '9', 'u', 'i', 'o'}},
-    {'9', {'8', '0', 'i', 'o', 'p'}},
-    {'0', {'9', '-', 'o', 'p', '['}},
-    {'-', {'0', '=', 'p', '[', ']'}},
-    {'=', {'-', '[', ']', '\\'}},
-    {'q', {'w'}},
-    {'w', {'q', 'e'}},
-    {'e', {'w', 'r'}},
-    {'r', {'e', 't'}},
-    {'t', {'r', 'y'}},
-    {'y', {'t', 'u'}},
-    {'u', {'y', 'i'}},
-    {'i', {'u', 'o'}},
-    {'o', {'i', 'p'}},
-    {'p', {'o', '['}},
-    {'[', {'p', ']'}},
-    {']', {'[', '\\'}},
-    {'\\', {']'}},
-    {'a', {'s'}},
-    {'s', {'a', 'd'}},
-    {'d', {'s', 'f'}},
-    {'f', {'d', 'g'}},
-    {'g', {'f', 'h'}},
-    {'h', {'g', 'j'}},
-    {'j', {'h', 'k'}},
-    {'k', {'j', 'l'}},
-    {'l', {'k', ';'}},
-    {';', {'l', '\''}},
-    {'\'', {';'}},
-    {'z', {'x'}},
-    {'x', {'z', 'c'}},
-    {'c', {'x', 'v'}},
-    {'v', {'c', 'b'}},
-    {'b', {'v', 'n'}},
-    {'n', {'b', 'm'}},
-    {'m', {'n', ','}},
-    {',', {'m', '.'}},
-    {'.', {',', '/'}},
-    {'/', {'.'}},
+// keys next to each other on a QWERTY keyboard
+static const struct {
+  char key;
+  const char* neighbors;
+} kKeyboardLayout[] = {
+    {'1', "2qw"},
+    {'2', "13qwe"},
+    {'3', "24wer"},
+    {'4', "35ert"},
+    {'5', "46rty"},
+    {'6', "57tyu"},
+    {'7', "68yui"},
+    {'8', "79uio"},
+    {'9', "80iop"},
+    {'0', "9-op["},
+    {'-', "0=p[]"},
+    {'=', "-[]\\"},
+    {'q', "w"},
+    {'w', "qe"},
+    {'e', "wr"},
+    {'r', "et"},
+    {'t', "ry"},
+    {'y', "tu"},
+    {'u', "yi"},
+    {'i', "uo"},
+    {'o', "ip"},
+    {'p', "o["},
+    {'[', "p]"},
+    {']', "[\\"},
+    {'\\', "]"},
+    {'a', "s"},
+    {'s', "ad"},
+    {'d', "sf"},
+    {'f', "dg"},
+    {'g', "fh"},
+    {'h', "gj"},
+    {'j', "hk"},
+    {'k', "jl"},
+    {'l', "k;"},
+    {';', "l'"},
+    {'\'', ";"},
+    {'z', "x"},
+    {'x', "zc"},
+    {'c', "xv"},
+    {'v', "cb"},
+    {'b', "vn"},
+    {'n', "bm"},
+    {'m', "n,"},
+    {',', "m."},
+    {'.', ",/"},
+    {'/', "."},
 };
 
+// a flat lookup table built from kKeyboardLayout
+class KeyboardAdjacency {
+ public:
+  KeyboardAdjacency() {
+    for (const auto& k : kKeyboardLayout) {
+      auto key = static_cast<unsigned char>(k.key);
+      neighbors_[key] = k.neighbors;
+      for (const char* p = k.neighbors; *p; ++p) {
+        auto neighbor = static_cast<unsigned char>(*p);
+        adjacency_[key][neighbor >> 6] |= uint64_t(1) << (neighbor & 63);
+      }
+    }
+  }
+  const char* neighbors(char c) const {
+    auto key = static_cast<unsigned char>(c);
+    return key < 128 && neighbors_[key] ? neighbors_[key] : "";
+  }
+  bool adjacent(char left, char right) const {
+    auto key = static_cast<unsigned char>(left);
+    auto neighbor = static_cast<unsigned char>(right);
+    return key < 128 && neighbor < 128 &&
+           (adjacency_[key][neighbor >> 6] >> (neighbor & 63) & 1);
+  }
+
+ private:
+  const char* neighbors_[128] = {};
+  uint64_t adjacency_[128][2] = {};
+};
+
+static const KeyboardAdjacency keyboard;
+
 void DFSCollect(const string& origin,
                 const string& current,
                 size_t ed,
@@ -152,7 +187,7 @@ void EditDistanceCorrector::ToleranceSearch(const Prism& prism,
 inline uint8_t SubstCost(char left, char right) {
   if (left == right)
     return 0;
-  if (keyboard_map[left].find(right) != keyboard_map[left].end()) {
+  if (keyboard.adjacent(left, right)) {
     return 1;
   }
   return 4;
@@ -243,49 +278,82 @@ bool EditDistanceCorrector::Build(const Syllabary& syllabary,
 EditDistanceCorrector::EditDistanceCorrector(const path& file_path)
     : Prism(file_path) {}
 
+// walks the prism level by level, trying each key and its neighbors on the
+// keyboard. of the states reaching the same trie node, only the one with the
+// least distance is kept.
 void NearSearchCorrector::ToleranceSearch(const Prism& prism,
                                           const string& key,
                                           Corrections* results,
                                           size_t threshold) {
   if (key.empty())
     return;
-
-  using record = struct {
-    size_t node_pos;
-    size_t idx;
-    size_t distance;
-    char ch;
-  };
-
-  std::queue<record> queue;
-  queue.push({0, 0, 0, key[0]});
-  for (auto subst : keyboard_map[key[0]]) {
-    queue.push({0, 0, 1, subst});
+  if (&prism != prism_ ||
+      prism.dict_file_checksum() != dict_file_checksum_ ||
+      prism.schema_file_checksum() != schema_file_checksum_ ||
+      threshold != threshold_) {
+    cache_.clear();
+    prism_ = &prism;
+    dict_file_checksum_ = prism.dict_file_checksum();
+    schema_file_checksum_ = prism.schema_file_checksum();
+    threshold_ = threshold;
   }
-  for (; !queue.empty(); queue.pop()) {
-    auto& rec = queue.front();
-    char ch = rec.ch;
-    char& exchange(const_cast<char*>(key.c_str())[rec.idx]);
-    std::swap(ch, exchange);
-    auto val =
-        prism.trie().traverse(key.c_str(), rec.node_pos, rec.idx, rec.idx + 1);
-    std::swap(ch, exchange);
-
+  // resume from the longest input searched before; on each keystroke, the
+  // input at every position extends that of the previous keystroke.
+  const Search* previous = nullptr;
+  for (size_t len = key.length(); len > 0 && !previous; --len) {
+    auto found = cache_.find(key.substr(0, len));
+    if (found != cache_.end())
+      previous = &found->second;
+  }
+  Search search;
+  size_t idx = 0;
+  if (previous) {
+    search = *previous;
+    idx = search.length;
+  } else {
+    search.frontier.push_back({0, 0});
+  }
+  vector<State> next;
+  hash_map<size_t, size_t> visited;
+  auto step = [&](const State& from, char ch, size_t distance) {
+    size_t node_pos = from.node_pos;
+    size_t key_pos = 0;
+    auto val = prism.trie().traverse(&ch, node_pos, key_pos, 1);
     if (val == -2)
-      continue;
+      return;
     if (val >= 0) {
-      results->Alter(val, {rec.distance, val, rec.idx});
+      search.results.Alter(val, {distance, val, idx + 1});
+    }
+    auto found = visited.find(node_pos);
+    if (found == visited.end()) {
+      visited[node_pos] = next.size();
+      next.push_back({node_pos, distance});
+    } else if (distance < next[found->second].distance) {
+      next[found->second].distance = distance;
     }
-    if (rec.idx < key.size()) {
-      queue.push({rec.node_pos, rec.idx, rec.distance, key[rec.idx]});
-      if (rec.distance < threshold) {
-        for (auto subst : keyboard_map[key[rec.idx]]) {
-          queue.push({rec.node_pos, rec.idx, rec.distance + 1, subst});
+  };
+  for (; idx < key.length() && !search.frontier.empty(); ++idx) {
+    next.clear();
+    visited.clear();
+    for (const State& state : search.frontier) {
+      step(state, key[idx], state.distance);
+      if (state.distance < threshold) {
+        for (const char* p = keyboard.neighbors(key[idx]); *p; ++p) {
+          step(state, *p, state.distance + 1);
         }
       }
     }
+    search.frontier.swap(next);
   }
+  search.length = key.length();
+  for (const auto& correction : search.results) {
+    results->Alter(correction.first, correction.second);
+  }
+  if (cache_.size() >= kMaxCachedSearches)
+    cache_.clear();
+  cache_[key] = std::move(search);
 }
+
 void CorrectorComponent::Unified::ToleranceSearch(const Prism& prism,
                                                   const string& key,
                                                   Corrections* results,
@@ -120,6 +120,26 @@ class RIME_DLL NearSearchCorrector : public Corrector {
                        const string& key,
                        corrector::Corrections* results,
                        size_t tolerance) override;
+
+ private:
+  struct State {
+    size_t node_pos;
+    size_t distance;
+  };
+  // a search for some input, which can be resumed for a longer input.
+  struct Search {
+    size_t length = 0;
+    corrector::Corrections results;
+    vector<State> frontier;
+  };
+  static const size_t kMaxCachedSearches = 256;
+
+  // a prism reloaded in place is told apart by its checksums.
+  const Prism* prism_ = nullptr;
+  uint32_t dict_file_checksum_ = 0;
+  uint32_t schema_file_checksum_ = 0;
+  size_t threshold_ = 0;
+  hash_map<string, Search> cache_;
 };
 
 template <class... Cs>
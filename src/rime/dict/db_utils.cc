@@ -25,14 +25,86 @@ int Source::Dump(Sink* sink) {
   return num_entries;
 }
 
-DbSink::DbSink(Db* db) : db_(db) {}
+// number of writes to commit at a time
+static const size_t kMaxBatchSize = 4096;
+
+DbSink::DbSink(Db* db)
+    : db_(db), transactional_(dynamic_cast<Transactional*>(db)) {}
+
+DbSink::~DbSink() {
+  Flush();
+}
 
 bool DbSink::MetaPut(const string& key, const string& value) {
-  return db_ && db_->MetaUpdate(key, value);
+  return MetaUpdate(key, value);
 }
 
 bool DbSink::Put(const string& key, const string& value) {
-  return db_ && db_->Update(key, value);
+  return Update(key, value);
+}
+
+bool DbSink::BeforeWrite() {
+  if (!db_)
+    return false;
+  // leave it to the caller if already in a transaction
+  if (transactional_ && !in_batch_ && !transactional_->in_transaction()) {
+    in_batch_ = transactional_->BeginTransaction();
+    batch_size_ = 0;
+  }
+  return true;
+}
+
+bool DbSink::AfterWrite(bool written) {
+  if (in_batch_ && ++batch_size_ >= kMaxBatchSize) {
+    return Flush() && written;
+  }
+  return written;
+}
+
+bool DbSink::Update(const string& key, const string& value) {
+  return BeforeWrite() && AfterWrite(db_->Update(key, value));
+}
+
+bool DbSink::MetaUpdate(const string& key, const string& value) {
+  return BeforeWrite() && AfterWrite(db_->MetaUpdate(key, value));
+}
+
+bool DbSink::Flush() {
+  if (!in_batch_)
+    return true;
+  in_batch_ = false;
+  batch_size_ = 0;
+  if (!transactional_->CommitTransaction()) {
+    LOG(ERROR) << "failed to commit writes to db '" << db_->name() << "'.";
+    return false;
+  }
+  return true;
+}
+
+bool DbSink::Fetch(const string& key, string* value) {
+  if (!db_ || !value)
+    return false;
+  if (cursor_ && key <= last_key_) {
+    // out of order; the cursor may have missed our own writes
+    Flush();
+    return db_->Fetch(key, value);
+  }
+  if (!cursor_) {
+    // let the cursor see everything written so far
+    Flush();
+    cursor_ = db_->QueryAll();
+    if (!cursor_)
+      return db_->Fetch(key, value);
+    cursor_valid_ = cursor_->GetNextRecord(&cursor_key_, &cursor_value_);
+  }
+  last_key_ = key;
+  while (cursor_valid_ && cursor_key_ < key) {
+    cursor_valid_ = cursor_->GetNextRecord(&cursor_key_, &cursor_value_);
+  }
+  if (!cursor_valid_ || cursor_key_ != key)
+    return false;
+  *value = cursor_value_;
+  return true;
 }
 
 DbSource::DbSource(Db* db)
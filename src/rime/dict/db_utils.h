@@ -45,16 +45,42 @@ int Source::operator>>(SinkType& sink) {
 
 class Db;
 class DbAccessor;
+class Transactional;
 
+// Writes records into a db, committing them in batches if the db supports
+// transactions.
 class DbSink : public Sink {
  public:
   explicit DbSink(Db* db);
+  virtual ~DbSink();
 
   virtual bool MetaPut(const string& key, const string& value);
   virtual bool Put(const string& key, const string& value);
 
+  // commits pending writes
+  bool Flush();
+
  protected:
+  // fetches the existing value of a key; records arriving in key order are
+  // looked up by walking a cursor alongside instead of point lookups.
+  bool Fetch(const string& key, string* value);
+  bool Update(const string& key, const string& value);
+  bool MetaUpdate(const string& key, const string& value);
+
   Db* db_;
+
+ private:
+  bool BeforeWrite();
+  bool AfterWrite(bool written);
+
+  Transactional* transactional_ = nullptr;
+  bool in_batch_ = false;
+  size_t batch_size_ = 0;
+  an<DbAccessor> cursor_;
+  bool cursor_valid_ = false;
+  string cursor_key_;
+  string cursor_value_;
+  string last_key_;
 };
 
 class DbSource : public Source {
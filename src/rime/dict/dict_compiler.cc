@@ -118,7 +118,8 @@ bool DictCompiler::Compile(const path& schema_file) {
   }
   if (prism_->Exists() && prism_->Load()) {
     rebuild_prism = prism_->dict_file_checksum() != dict_file_checksum ||
-                    prism_->schema_file_checksum() != schema_file_checksum;
+                    prism_->schema_file_checksum() != schema_file_checksum ||
+                    !prism_->has_completion_index();
     prism_->Close();
   } else {
     rebuild_prism = true;
@@ -316,6 +317,8 @@ bool DictCompiler::BuildPrism(const path& schema_file,
       return false;
     }
     Projection p;
+    // evaluate large syllabaries on all available cores
+    p.set_num_threads(0);
     auto algebra = config.GetList("speller/algebra");
     if (algebra && p.Load(algebra)) {
       for (const auto& x : syllabary) {
@@ -353,11 +356,22 @@ bool DictCompiler::BuildPrism(const path& schema_file,
     dump_path.replace_extension(".txt");
     script.Dump(dump_path);
   }
+  // rank completions by the best single-syllable word of each syllable;
+  // homophones in the table are sorted by weight desc.
+  const prism::Weight kMinSyllableWeight = log(DBL_EPSILON);
+  vector<prism::Weight> syllable_weights(syllabary.size(), kMinSyllableWeight);
+  for (SyllableId syllable_id = 0;
+       syllable_id < static_cast<SyllableId>(syllabary.size()); ++syllable_id) {
+    TableAccessor accessor = primary_table->QueryWords(syllable_id);
+    if (!accessor.exhausted())
+      syllable_weights[syllable_id] = accessor.entry()->weight();
+  }
   // build .prism.bin
   {
     prism_->Remove();
     if (!prism_->Build(syllabary, script.empty() ? nullptr : &script,
-                       dict_file_checksum, schema_file_checksum) ||
+                       dict_file_checksum, schema_file_checksum,
+                       &syllable_weights) ||
         !prism_->Save()) {
       return false;
     }
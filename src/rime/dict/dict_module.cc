@@ -15,6 +15,7 @@
 #include <rime/dict/user_db.h>
 #include <rime/dict/corrector.h>
 #include <rime/dict/dictionary.h>
+#include <rime/dict/resource_preloading_task.h>
 #include <rime/dict/reverse_lookup_dictionary.h>
 #include <rime/dict/user_dictionary.h>
 #include <rime/dict/user_db_recovery_task.h>
@@ -40,6 +41,8 @@ static void rime_dict_initialize() {
   r.Register("user_dictionary", new UserDictionaryComponent);
 
   r.Register("userdb_recovery_task", new UserDbRecoveryTaskComponent);
+  r.Register("preload_resources", new ResourcePreloadingTaskComponent(false));
+  r.Register("pin_resources", new ResourcePreloadingTaskComponent(true));
 }
 
 static void rime_dict_finalize() {}
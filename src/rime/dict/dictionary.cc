@@ -5,6 +5,7 @@
 // 2011-07-05 GONG Chen <chen.sst@gmail.com>
 //
 #include <filesystem>
+#include <mutex>
 #include <rime/algo/syllabifier.h>
 #include <rime/common.h>
 #include <rime/dict/dictionary.h>
@@ -79,8 +80,36 @@ bool compare_chunk_by_head_element(const Chunk& a, const Chunk& b) {
     return a.is_exact_match() > b.is_exact_match();
   if (a.remaining_code.length() != b.remaining_code.length())
     return a.remaining_code.length() < b.remaining_code.length();
-  return a.credibility + a.entries[a.cursor].weight >
-         b.credibility + b.entries[b.cursor].weight;  // by weight desc
+  return a.credibility + a.entries[a.cursor].weight() >
+         b.credibility + b.entries[b.cursor].weight();  // by weight desc
+}
+
+inline bool in_length_class(const table::Entry& entry,
+                            LengthClass length_class) {
+  return length_class == kAnyLength ||
+         entry.single_char() == (length_class == kSingleChar);
+}
+
+// moves the cursor to the first entry in the length class.
+// returns false if no more entries are left in the chunk.
+bool seek_entry(Chunk* chunk, LengthClass length_class) {
+  while (chunk->cursor < chunk->size &&
+         !in_length_class(chunk->entries[chunk->cursor], length_class)) {
+    ++chunk->cursor;
+  }
+  return chunk->cursor < chunk->size;
+}
+
+// the number of entries in the length class from the cursor on.
+size_t count_entries(const Chunk& chunk, LengthClass length_class) {
+  if (length_class == kAnyLength)
+    return chunk.size - chunk.cursor;
+  size_t count = 0;
+  for (size_t i = chunk.cursor; i < chunk.size; ++i) {
+    if (in_length_class(chunk.entries[i], length_class))
+      ++count;
+  }
+  return count;
 }
 
 struct CodeMatch {
@@ -128,8 +157,10 @@ DictEntryIterator::DictEntryIterator()
     : query_result_(New<dictionary::QueryResult>()) {}
 
 void DictEntryIterator::AddChunk(dictionary::Chunk&& chunk) {
+  if (!dictionary::seek_entry(&chunk, length_class_))
+    return;
+  entry_count_ += dictionary::count_entries(chunk, length_class_);
   query_result_->chunks.push_back(std::move(chunk));
-  entry_count_ += chunk.size;
 }
 
 void DictEntryIterator::Sort() {
@@ -161,7 +192,7 @@ an<DictEntry> DictEntryIterator::Peek() {
     entry_->code = chunk.code;
     entry_->text = chunk.table->GetEntryText(e);
     const double kS = 18.420680743952367;  // log(1e8)
-    entry_->weight = e.weight - kS + chunk.credibility;
+    entry_->weight = e.weight() - kS + chunk.credibility;
     entry_->quality_len = chunk.quality_len;
     if (!chunk.remaining_code.empty()) {
       entry_->comment = "~" + chunk.remaining_code;
@@ -179,7 +210,8 @@ bool DictEntryIterator::FindNextEntry() {
     return false;
   }
   auto& chunk = query_result_->chunks[chunk_index_];
-  if (++chunk.cursor >= chunk.size) {
+  ++chunk.cursor;
+  if (!dictionary::seek_entry(&chunk, length_class_)) {
     ++chunk_index_;
   }
   if (exhausted()) {
@@ -200,12 +232,21 @@ bool DictEntryIterator::Next() {
   return true;
 }
 
-// Note: does not apply filters
+// Note: does not apply filters; entries out of the length class are not
+// counted.
 bool DictEntryIterator::Skip(size_t num_entries) {
   while (num_entries > 0) {
     if (exhausted())
       return false;
     auto& chunk = query_result_->chunks[chunk_index_];
+    if (length_class_ != kAnyLength) {
+      ++chunk.cursor;
+      --num_entries;
+      if (!dictionary::seek_entry(&chunk, length_class_)) {
+        ++chunk_index_;
+      }
+      continue;
+    }
     if (chunk.cursor + num_entries < chunk.size) {
       chunk.cursor += num_entries;
       return true;
@@ -300,10 +341,12 @@ size_t Dictionary::LookupWords(DictEntryIterator* result,
                                const string& str_code,
                                bool predictive,
                                size_t expand_search_limit,
-                               const hash_set<string>* blacklist) {
+                               const hash_set<string>* blacklist,
+                               LengthClass length_class) {
   DLOG(INFO) << "lookup: " << str_code;
   if (!loaded())
     return 0;
+  result->set_length_class(length_class);
   vector<Prism::Match> keys;
   if (predictive) {
     prism_->ExpandSearch(str_code, &keys, expand_search_limit);
@@ -377,6 +420,9 @@ bool Dictionary::Remove() {
 }
 
 bool Dictionary::Load() {
+  // tables are shared, and may be loaded in the background by preloading.
+  static std::mutex load_mutex;
+  std::lock_guard<std::mutex> lock(load_mutex);
   LOG(INFO) << "loading dictionary '" << name_ << "'.";
   if (tables_.empty()) {
     LOG(ERROR) << "Cannot load dictionary '" << name_
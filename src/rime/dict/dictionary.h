@@ -23,6 +23,13 @@ struct QueryResult;
 
 }  // namespace dictionary
 
+// restricts a lookup to entries of certain text length.
+enum LengthClass {
+  kAnyLength,
+  kSingleChar,
+  kMultiChar,
+};
+
 class RIME_DLL DictEntryIterator : public DictEntryFilterBinder {
  public:
   DictEntryIterator();
@@ -40,6 +47,10 @@ class RIME_DLL DictEntryIterator : public DictEntryFilterBinder {
   bool Skip(size_t num_entries);
   bool exhausted() const;
   size_t entry_count() const { return entry_count_; }
+  // entries out of the length class are skipped before they are created.
+  void set_length_class(LengthClass length_class) {
+    length_class_ = length_class;
+  }
 
  protected:
   bool FindNextEntry();
@@ -49,6 +60,7 @@ class RIME_DLL DictEntryIterator : public DictEntryFilterBinder {
   size_t chunk_index_ = 0;
   an<DictEntry> entry_ = nullptr;
   size_t entry_count_ = 0;
+  LengthClass length_class_ = kAnyLength;
 };
 
 using DictEntryCollector = map<size_t, DictEntryIterator>;
@@ -84,7 +96,8 @@ class Dictionary : public Class<Dictionary, const Ticket&> {
                               const string& str_code,
                               bool predictive,
                               size_t limit = 0,
-                              const hash_set<string>* blacklist = nullptr);
+                              const hash_set<string>* blacklist = nullptr,
+                              LengthClass length_class = kAnyLength);
   // translate syllable id sequence to string code
   RIME_DLL bool Decode(const Code& code, vector<string>* result);
 
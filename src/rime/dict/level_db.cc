@@ -5,9 +5,13 @@
 // 2014-12-04 Chen Gong <chen.sst@gmail.com>
 //
 
+#include <mutex>
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
+#include <leveldb/filter_policy.h>
 #include <leveldb/write_batch.h>
 #include <rime/common.h>
+#include <rime/config.h>
 #include <rime/service.h>
 #include <rime/dict/level_db.h>
 #include <rime/dict/user_db.h>
@@ -16,12 +20,59 @@ namespace rime {
 
 static const char* kMetaCharacter = "\x01";
 
+LevelDbOptions::LevelDbOptions() = default;
+
+LevelDbOptions::~LevelDbOptions() = default;
+
+void LevelDbOptions::Load(Config* config, const string& db_type) {
+  if (config) {
+    config->GetInt(db_type + "/block_cache_size", &block_cache_size);
+    config->GetInt(db_type + "/write_buffer_size", &write_buffer_size);
+    config->GetInt(db_type + "/bloom_filter_bits", &bloom_filter_bits);
+    config->GetBool(db_type + "/compression", &compression);
+    config->GetBool(db_type + "/fill_cache", &fill_cache);
+    configured = true;
+  }
+  if (block_cache_size > 0) {
+    block_cache.reset(leveldb::NewLRUCache(block_cache_size));
+  }
+  if (bloom_filter_bits > 0) {
+    filter_policy.reset(leveldb::NewBloomFilterPolicy(bloom_filter_bits));
+  }
+}
+
+void LevelDbOptions::Apply(leveldb::Options* options) const {
+  if (block_cache)
+    options->block_cache = block_cache.get();
+  if (filter_policy)
+    options->filter_policy = filter_policy.get();
+  if (write_buffer_size > 0)
+    options->write_buffer_size = write_buffer_size;
+  options->compression =
+      compression ? leveldb::kSnappyCompression : leveldb::kNoCompression;
+}
+
+const LevelDbOptions& LevelDbOptions::ForDbType(const string& db_type,
+                                                Config* config) {
+  static std::mutex mutex;
+  // never freed, since dbs may still be open at exit; nor are the defaults
+  // when replaced, since dbs opened before may still use them.
+  static auto* options_by_type = new map<string, LevelDbOptions*>;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& options = (*options_by_type)[db_type];
+  if (!options || (config && !options->configured)) {
+    options = new LevelDbOptions;
+    options->Load(config, db_type);
+  }
+  return *options;
+}
+
 struct LevelDbCursor {
   leveldb::Iterator* iterator = nullptr;
 
-  LevelDbCursor(leveldb::DB* db) {
+  LevelDbCursor(leveldb::DB* db, bool fill_cache) {
     leveldb::ReadOptions options;
-    options.fill_cache = false;
+    options.fill_cache = fill_cache;
     iterator = db->NewIterator(options);
   }
 
@@ -50,9 +101,14 @@ struct LevelDbCursor {
 struct LevelDbWrapper {
   leveldb::DB* ptr = nullptr;
   leveldb::WriteBatch batch;
+  const LevelDbOptions* db_options = nullptr;
 
-  leveldb::Status Open(const path& file_path, bool readonly) {
+  leveldb::Status Open(const path& file_path,
+                       const string& db_type,
+                       bool readonly) {
+    db_options = &LevelDbOptions::ForDbType(db_type);
     leveldb::Options options;
+    db_options->Apply(&options);
     options.create_if_missing = !readonly;
     return leveldb::DB::Open(options, file_path.string(), &ptr);
   }
@@ -62,7 +118,9 @@ struct LevelDbWrapper {
     ptr = nullptr;
   }
 
-  LevelDbCursor* CreateCursor() { return new LevelDbCursor(ptr); }
+  LevelDbCursor* CreateCursor() {
+    return new LevelDbCursor(ptr, db_options && db_options->fill_cache);
+  }
 
   bool Fetch(const string& key, string* value) {
     auto status = ptr->Get(leveldb::ReadOptions(), key, value);
@@ -139,6 +197,13 @@ bool LevelDbAccessor::exhausted() {
 
 // LevelDb members
 
+void LevelDb::LoadOptions(const string& db_type) {
+  if (auto component = Config::Require("config")) {
+    the<Config> config(component->Create("default"));
+    LevelDbOptions::ForDbType(db_type, config.get());
+  }
+}
+
 LevelDb::LevelDb(const path& file_path,
                  const string& db_name,
                  const string& db_type)
@@ -244,7 +309,7 @@ bool LevelDb::Open() {
     return false;
   Initialize();
   readonly_ = false;
-  auto status = db_->Open(file_path(), readonly_);
+  auto status = db_->Open(file_path(), db_type_, readonly_);
   loaded_ = status.ok();
 
   if (loaded_) {
@@ -266,7 +331,7 @@ bool LevelDb::OpenReadOnly() {
     return false;
   Initialize();
   readonly_ = true;
-  auto status = db_->Open(file_path(), readonly_);
+  auto status = db_->Open(file_path(), db_type_, readonly_);
   loaded_ = status.ok();
 
   if (!loaded_) {
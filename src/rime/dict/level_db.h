@@ -9,11 +9,49 @@
 
 #include <rime/dict/db.h>
 
+namespace leveldb {
+class Cache;
+class FilterPolicy;
+struct Options;
+}  // namespace leveldb
+
 namespace rime {
 
+class Config;
 struct LevelDbCursor;
 struct LevelDbWrapper;
 
+// Tuning of the dbs of a class, read from `<db_type>/...` in default.yaml.
+// The block cache and the bloom filter policy are shared by all dbs of the
+// class open in the process.
+// Dbs may be opened on the deployer's threads, which must not access config
+// components; so the options are read on the main thread, when the first user
+// dictionary is created. Until then, dbs of the class have the defaults.
+struct RIME_DLL LevelDbOptions {
+  int block_cache_size = 8 << 20;
+  // 0 for the leveldb default
+  int write_buffer_size = 0;
+  // bits per key; 0 disables bloom filters
+  int bloom_filter_bits = 10;
+  bool compression = true;
+  // whether prefix scans of user dict lookups fill the block cache
+  bool fill_cache = false;
+  // whether read from config, or else the defaults
+  bool configured = false;
+
+  the<leveldb::Cache> block_cache;
+  the<const leveldb::FilterPolicy> filter_policy;
+
+  LevelDbOptions();
+  ~LevelDbOptions();
+  void Load(Config* config, const string& db_type);
+  void Apply(leveldb::Options* options) const;
+
+  // the options are read from config the first time one is given.
+  static const LevelDbOptions& ForDbType(const string& db_type,
+                                         Config* config = nullptr);
+};
+
 class LevelDb;
 
 class LevelDbAccessor : public DbAccessor {
@@ -39,6 +77,10 @@ class LevelDb : public Db, public Recoverable, public Transactional {
           const string& db_type = "");
   virtual ~LevelDb();
 
+  // reads the options of a db type from default.yaml, if not yet read. call
+  // it on the main thread; dbs of the type opened before have the defaults.
+  static void LoadOptions(const string& db_type);
+
   bool Remove() override;
   bool Open() override;
   bool OpenReadOnly() override;
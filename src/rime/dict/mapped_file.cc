@@ -6,6 +6,7 @@
 //
 // 2011-06-30 GONG Chen <chen.sst@gmail.com>
 //
+#include <cstring>
 #include <fstream>
 #include <filesystem>
 #include <boost/interprocess/file_mapping.hpp>
@@ -21,6 +22,7 @@ class MappedFileImpl {
     kOpenReadWrite,
   };
 
+  // maps the file into memory.
   MappedFileImpl(const path& file_path, OpenMode mode) {
     boost::interprocess::mode_t file_mapping_mode =
         (mode == kOpenReadOnly) ? boost::interprocess::read_only
@@ -30,19 +32,54 @@ class MappedFileImpl {
     region_.reset(
         new boost::interprocess::mapped_region(*file_, file_mapping_mode));
   }
+  // builds the image in an anonymous buffer, to be written out at once.
+  explicit MappedFileImpl(size_t capacity) : buffer_(capacity) {}
   ~MappedFileImpl() {
     region_.reset();
     file_.reset();
   }
-  bool Flush() { return region_->flush(); }
-  void* get_address() const { return region_->get_address(); }
-  size_t get_size() const { return region_->get_size(); }
+  bool in_memory() const { return !region_; }
+  bool Grow(size_t capacity) {
+    if (!in_memory())
+      return false;
+    buffer_.resize(capacity);
+    return true;
+  }
+  bool Flush(bool async = true) {
+    return in_memory() || region_->flush(0, 0, async);
+  }
+  bool WarmUp() {
+    return !in_memory() &&
+           region_->advise(
+               boost::interprocess::mapped_region::advice_willneed);
+  }
+  void* get_address() const {
+    return in_memory() ? (void*)buffer_.data() : region_->get_address();
+  }
+  size_t get_size() const {
+    return in_memory() ? buffer_.size() : region_->get_size();
+  }
 
  private:
   the<boost::interprocess::file_mapping> file_;
   the<boost::interprocess::mapped_region> region_;
+  vector<char> buffer_;
 };
 
+static bool create_file(const path& file_path, size_t capacity) {
+  std::filebuf fbuf;
+  if (!fbuf.open(file_path.c_str(), std::ios_base::in | std::ios_base::out |
+                                        std::ios_base::trunc |
+                                        std::ios_base::binary)) {
+    return false;
+  }
+  if (capacity > 0) {
+    fbuf.pubseekoff(capacity - 1, std::ios_base::beg);
+    fbuf.sputc(0);
+  }
+  return fbuf.close() != nullptr;
+}
+
 MappedFile::MappedFile(const path& file_path) : file_path_(file_path) {}
 
 MappedFile::~MappedFile() {
@@ -52,23 +89,8 @@ MappedFile::~MappedFile() {
 }
 
 bool MappedFile::Create(size_t capacity) {
-  if (Exists()) {
-    LOG(INFO) << "overwriting file '" << file_path_ << "'.";
-    Resize(capacity);
-  } else {
-    LOG(INFO) << "creating file '" << file_path_ << "'.";
-    std::filebuf fbuf;
-    fbuf.open(file_path_.c_str(), std::ios_base::in | std::ios_base::out |
-                                      std::ios_base::trunc |
-                                      std::ios_base::binary);
-    if (capacity > 0) {
-      fbuf.pubseekoff(capacity - 1, std::ios_base::beg);
-      fbuf.sputc(0);
-    }
-    fbuf.close();
-  }
-  LOG(INFO) << "opening file for read/write access.";
-  file_.reset(new MappedFileImpl(file_path_, MappedFileImpl::kOpenReadWrite));
+  LOG(INFO) << "building file '" << file_path_ << "' in memory.";
+  file_.reset(new MappedFileImpl(capacity));
   size_ = 0;
   return bool(file_);
 }
@@ -114,11 +136,57 @@ bool MappedFile::Flush() {
   return file_->Flush();
 }
 
+bool MappedFile::WarmUp() {
+  if (!file_)
+    return false;
+  return file_->WarmUp();
+}
+
 bool MappedFile::ShrinkToFit() {
   LOG(INFO) << "shrinking file to fit data size. capacity: " << capacity();
+  if (file_ && file_->in_memory()) {
+    return Commit();
+  }
   return Resize(size_);
 }
 
+bool MappedFile::Commit() {
+  path temp_path = file_path_;
+  temp_path += ".tmp";
+  LOG(INFO) << "writing " << size_ << " bytes to file '" << file_path_
+            << "'.";
+  try {
+    if (!create_file(temp_path, size_)) {
+      LOG(ERROR) << "error creating file '" << temp_path << "'.";
+      return false;
+    }
+    if (size_ > 0) {
+      MappedFileImpl temp_file(temp_path, MappedFileImpl::kOpenReadWrite);
+      std::memcpy(temp_file.get_address(), address(), size_);
+      if (!temp_file.Flush(false)) {
+        LOG(ERROR) << "error flushing file '" << temp_path << "'.";
+        std::filesystem::remove(temp_path);
+        return false;
+      }
+    }
+    Close();
+    std::filesystem::rename(temp_path, file_path_);
+  } catch (const std::exception& ex) {
+    LOG(ERROR) << "error writing file '" << file_path_ << "': " << ex.what();
+    std::error_code ec;
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+bool MappedFile::Grow(size_t capacity) {
+  if (file_ && file_->in_memory()) {
+    return file_->Grow(capacity);
+  }
+  return Resize(capacity) && OpenReadWrite();
+}
+
 bool MappedFile::Remove() {
   if (IsOpen())
     Close();
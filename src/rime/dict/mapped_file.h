@@ -86,11 +86,15 @@ class RIME_DLL MappedFile {
   explicit MappedFile(const path& file_path);
   virtual ~MappedFile();
 
+  // starts building the file in memory; nothing is written to disk until
+  // ShrinkToFit() commits the image.
   bool Create(size_t capacity);
   bool OpenReadOnly();
   bool OpenReadWrite();
   bool Flush();
   bool Resize(size_t capacity);
+  // truncates the file to the data size. a file being built is written to a
+  // temporary file, synced and renamed into place, then closed.
   bool ShrinkToFit();
 
   template <class T>
@@ -114,6 +118,8 @@ class RIME_DLL MappedFile {
   bool IsOpen() const;
   void Close();
   bool Remove();
+  // advises the OS to read the mapped pages ahead of their first access.
+  bool WarmUp();
 
   template <class T>
   T* Find(size_t offset);
@@ -122,6 +128,9 @@ class RIME_DLL MappedFile {
   size_t file_size() const { return size_; }
 
  private:
+  bool Grow(size_t capacity);
+  bool Commit();
+
   path file_path_;
   size_t size_ = 0;
   the<MappedFileImpl> file_;
@@ -142,7 +151,7 @@ T* MappedFile::Allocate(size_t count) {
   if (used_space + required_space > file_size) {
     // not enough space; grow the file
     size_t new_size = (std::max)(used_space + required_space, file_size * 2);
-    if (!Resize(new_size) || !OpenReadWrite())
+    if (!Grow(new_size))
       return NULL;
   }
   T* ptr = reinterpret_cast<T*>(address() + used_space);
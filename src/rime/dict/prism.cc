@@ -7,6 +7,7 @@
 //
 #include <cfloat>
 #include <cstring>
+#include <limits>
 #include <queue>
 #include <rime/algo/algebra.h>
 #include <rime/dict/prism.h>
@@ -20,14 +21,40 @@ struct node_t {
   size_t node_pos;
 };
 
+struct candidate_t {
+  prism::Weight weight;
+  string key;
+  size_t node_pos;
+  // spelling id, or -1 for a subtree yet to expand
+  int value;
+
+  // ordered for a max-heap: higher weight first, then smaller key
+  bool operator<(const candidate_t& other) const {
+    if (weight != other.weight)
+      return weight < other.weight;
+    if (key != other.key)
+      return key > other.key;
+    return value < other.value;
+  }
+};
+
+// weight of a subtree that has no keys below the node
+const prism::Weight kNoDescendants =
+    -std::numeric_limits<prism::Weight>::infinity();
+// weight of a key that maps to no syllables eligible for completion
+const prism::Weight kMinKeyWeight =
+    std::numeric_limits<prism::Weight>::lowest();
+
 // 在 SpellingDescriptor::type 的高位記錄 is_correction, 避開符號位
 const int32_t kTypeIsCorrectionMask = 1 << 30;
 const int32_t kSpellingTypeMask = ~kTypeIsCorrectionMask;
 
 }  // namespace
 
-const char kPrismFormat[] = "Rime::Prism/4.0";
-const double kPrismFormatVersion = 4.0;
+const char kPrismFormat[] = "Rime::Prism/4.1";
+const double kPrismFormatVersion = 4.1;
+// v4.0 files are compatible but lack the completion index
+const double kPrismMinFormatVersion = 4.0;
 
 const char kPrismFormatPrefix[] = "Rime::Prism/";
 const size_t kPrismFormatPrefixLen = sizeof(kPrismFormatPrefix) - 1;
@@ -104,7 +131,7 @@ bool Prism::Load() {
   format_ = atof(&metadata_->format[kPrismFormatPrefixLen]);
 
   // 版本檢查: 強制重構舊版本
-  if (format_ < kPrismFormatVersion - DBL_EPSILON) {
+  if (format_ < kPrismMinFormatVersion - DBL_EPSILON) {
     LOG(INFO) << "prism format " << format_ << " is too old. upgrading to "
               << kPrismFormatVersion;
     Close();
@@ -125,6 +152,20 @@ bool Prism::Load() {
   if (format_ > 1.0 - DBL_EPSILON) {
     spelling_map_ = metadata_->spelling_map.get();
   }
+  key_weights_ = NULL;
+  node_weights_ = NULL;
+  if (format_ >= kPrismFormatVersion - DBL_EPSILON) {
+    auto key_weights = metadata_->key_weights.get();
+    auto node_weights = metadata_->node_weights.get();
+    if (key_weights && node_weights &&
+        key_weights->size == metadata_->num_spellings &&
+        node_weights->size == array_size) {
+      key_weights_ = key_weights;
+      node_weights_ = node_weights;
+    } else {
+      LOG(WARNING) << "completion index not found.";
+    }
+  }
   return true;
 }
 
@@ -139,7 +180,8 @@ bool Prism::Save() {
 bool Prism::Build(const Syllabary& syllabary,
                   const Script* script,
                   uint32_t dict_file_checksum,
-                  uint32_t schema_file_checksum) {
+                  uint32_t schema_file_checksum,
+                  const vector<prism::Weight>* syllable_weights) {
   // building double-array trie
   size_t num_syllables = syllabary.size();
   size_t num_spellings = script ? script->size() : syllabary.size();
@@ -167,6 +209,11 @@ bool Prism::Build(const Syllabary& syllabary,
   size_t estimated_map_size =
       num_spellings * 12 +
       map_size * (4 + sizeof(prism::SpellingDescriptor) + kDescriptorExtraSize);
+  if (syllable_weights) {
+    // key weights and node weights
+    estimated_map_size +=
+        (num_spellings + array_size + 2) * sizeof(prism::Weight);
+  }
   const size_t kReservedSize = 1024;
   if (!Create(image_size + estimated_map_size + kReservedSize)) {
     LOG(ERROR) << "Error creating prism file '" << file_path() << "'.";
@@ -247,12 +294,68 @@ bool Prism::Build(const Syllabary& syllabary,
     metadata->spelling_map = spelling_map;
     spelling_map_ = spelling_map;
   }
+  key_weights_ = NULL;
+  node_weights_ = NULL;
+  if (syllable_weights && !BuildCompletionIndex(*syllable_weights, keys)) {
+    return false;
+  }
   // at last, complete the metadata
   std::strncpy(metadata->format, kPrismFormat,
                prism::Metadata::kFormatMaxLength);
   return true;
 }
 
+bool Prism::BuildCompletionIndex(const vector<prism::Weight>& syllable_weights,
+                                 const vector<const char*>& keys) {
+  size_t num_spellings = keys.size();
+  auto key_weights = CreateArray<prism::Weight>(num_spellings);
+  if (!key_weights) {
+    LOG(ERROR) << "Error creating key weights.";
+    return false;
+  }
+  for (size_t i = 0; i < num_spellings; ++i) {
+    prism::Weight& weight(key_weights->at[i]);
+    weight = kMinKeyWeight;
+    // a spelling is as good as the best syllable it completes to
+    for (SpellingAccessor accessor(spelling_map_, i); !accessor.exhausted();
+         accessor.Next()) {
+      SyllableId syllable_id = accessor.syllable_id();
+      SpellingProperties props = accessor.properties();
+      if (props.type >= kAbbreviation || props.is_correction ||
+          syllable_id < 0 ||
+          static_cast<size_t>(syllable_id) >= syllable_weights.size())
+        continue;
+      weight = (std::max)(
+          weight, prism::Weight(syllable_weights[syllable_id] +
+                                props.credibility));
+    }
+  }
+  size_t array_size = trie_->size();
+  auto node_weights = CreateArray<prism::Weight>(array_size);
+  if (!node_weights) {
+    LOG(ERROR) << "Error creating node weights.";
+    return false;
+  }
+  std::fill(node_weights->begin(), node_weights->end(), kNoDescendants);
+  // propagate key weights to every node on the path, excluding the key's own
+  for (size_t i = 0; i < num_spellings; ++i) {
+    const char* key = keys[i];
+    size_t key_length = std::strlen(key);
+    size_t node_pos = 0;
+    for (size_t key_pos = 0; key_pos < key_length;) {
+      prism::Weight& weight(node_weights->at[node_pos]);
+      weight = (std::max)(weight, key_weights->at[i]);
+      if (trie_->traverse(key, node_pos, key_pos, key_pos + 1) == -2)
+        break;
+    }
+  }
+  metadata_->key_weights = key_weights;
+  metadata_->node_weights = node_weights;
+  key_weights_ = key_weights;
+  node_weights_ = node_weights;
+  return true;
+}
+
 bool Prism::HasKey(const string& key) {
   int value = trie_->exactMatchSearch<int>(key.c_str());
   return value != -1;
@@ -279,6 +382,38 @@ void Prism::CommonPrefixSearch(const string& key, vector<Match>* result) {
   result->resize(num_results);
 }
 
+void Prism::CommonPrefixSearchAll(const string& key, MatchTable* result) {
+  if (!result)
+    return;
+  result->trie_ = trie_.get();
+  result->key_ = key;
+  result->matches_.clear();
+  result->ranges_.assign(key.length(), {0, 0});
+  result->searched_.assign(key.length(), false);
+  result->buffer_.resize(key.length());
+}
+
+const Prism::MatchTable::Range& Prism::MatchTable::Search(size_t pos) {
+  static const Range kNoMatch{0, 0};
+  if (pos >= key_.length())
+    return kNoMatch;
+  Range& range = ranges_[pos];
+  if (searched_[pos])
+    return range;
+  searched_[pos] = true;
+  // there is at most one match of each length.
+  size_t max_results = key_.length() - pos;
+  size_t num_results = trie_ ? trie_->commonPrefixSearch(
+                                   key_.c_str() + pos, buffer_.data(),
+                                   max_results, max_results)
+                             : 0;
+  size_t begin = matches_.size();
+  matches_.insert(matches_.end(), buffer_.begin(),
+                  buffer_.begin() + (std::min)(num_results, max_results));
+  range = {begin, matches_.size()};
+  return range;
+}
+
 void Prism::ExpandSearch(const string& key,
                          vector<Match>* result,
                          size_t limit) {
@@ -323,6 +458,63 @@ void Prism::ExpandSearch(const string& key,
   }
 }
 
+void Prism::TopKExpandSearch(const string& key,
+                             vector<Match>* result,
+                             size_t limit) {
+  if (!node_weights_) {
+    ExpandSearch(key, result, limit);
+    return;
+  }
+  if (!result)
+    return;
+  result->clear();
+  size_t node_pos = 0;
+  size_t key_pos = 0;
+  int ret = trie_->traverse(key.c_str(), node_pos, key_pos);
+  // key is not a valid path
+  if (ret == -2)
+    return;
+  if (ret != -1) {
+    result->push_back(Match{ret, key_pos});
+    if (limit && result->size() >= limit)
+      return;
+  }
+  BestFirstExpandSearch(key, node_pos, result, limit);
+}
+
+// Visits subtrees in order of the best key weight below each node, so that
+// the first `limit` keys found are the best completions of the given key.
+void Prism::BestFirstExpandSearch(const string& key,
+                                  size_t node_pos,
+                                  vector<Match>* result,
+                                  size_t limit) {
+  std::priority_queue<candidate_t> q;
+  if (node_weights_->at[node_pos] != kNoDescendants)
+    q.push({node_weights_->at[node_pos], key, node_pos, -1});
+  while (!q.empty()) {
+    candidate_t node = q.top();
+    q.pop();
+    if (node.value >= 0) {
+      result->push_back(Match{node.value, node.key.length()});
+      if (limit && result->size() >= limit)
+        return;
+      continue;
+    }
+    for (const char* c = metadata_->alphabet; *c; ++c) {
+      string k = node.key + *c;
+      size_t k_pos = node.key.length();
+      size_t n_pos = node.node_pos;
+      int ret = trie_->traverse(k.c_str(), n_pos, k_pos);
+      if (ret <= -2)
+        continue;
+      if (ret >= 0 && static_cast<size_t>(ret) < key_weights_->size)
+        q.push({key_weights_->at[ret], k, n_pos, ret});
+      if (node_weights_->at[n_pos] != kNoDescendants)
+        q.push({node_weights_->at[n_pos], k, n_pos, -1});
+    }
+  }
+}
+
 SpellingAccessor Prism::QuerySpelling(SyllableId spelling_id) {
   return SpellingAccessor(spelling_map_, spelling_id);
 }
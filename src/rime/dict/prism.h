@@ -20,6 +20,7 @@ namespace rime {
 namespace prism {
 
 using Credibility = float;
+using Weight = float;
 
 struct SpellingDescriptor {
   SyllableId syllable_id;
@@ -31,6 +32,7 @@ struct SpellingDescriptor {
 
 using SpellingMapItem = List<SpellingDescriptor>;
 using SpellingMap = Array<SpellingMapItem>;
+using WeightMap = Array<Weight>;
 
 struct Metadata {
   static const int kFormatMaxLength = 32;
@@ -44,6 +46,11 @@ struct Metadata {
   // v1.0
   OffsetPtr<SpellingMap> spelling_map;
   char alphabet[256];
+  // v4.1
+  // best weight of the syllables each spelling key maps to
+  OffsetPtr<WeightMap> key_weights;
+  // indexed by trie node position: max weight of keys below the node
+  OffsetPtr<WeightMap> node_weights;
 };
 
 }  // namespace prism
@@ -68,6 +75,36 @@ class Prism : public MappedFile {
  public:
   using Match = Darts::DoubleArray::result_pair_type;
 
+  // spellings matching the input at each position, in a flat array.
+  // a position is searched the first time its matches are read, so that
+  // positions never reached by the caller cost nothing.
+  class MatchTable {
+   public:
+    // a search may grow the table; read data() only after it.
+    const Match* begin(size_t pos) {
+      size_t offset = Search(pos).first;
+      return matches_.data() + offset;
+    }
+    const Match* end(size_t pos) {
+      size_t offset = Search(pos).second;
+      return matches_.data() + offset;
+    }
+
+   private:
+    friend class Prism;
+    // [begin, end) of the matches at pos in matches_.
+    using Range = pair<size_t, size_t>;
+    const Range& Search(size_t pos);
+
+    Darts::DoubleArray* trie_ = nullptr;
+    string key_;
+    vector<Match> matches_;
+    vector<Range> ranges_;
+    vector<bool> searched_;
+    // where the trie writes the matches at a position
+    vector<Match> buffer_;
+  };
+
   RIME_DLL explicit Prism(const path& file_path);
 
   RIME_DLL bool Load();
@@ -75,26 +112,45 @@ class Prism : public MappedFile {
   RIME_DLL bool Build(const Syllabary& syllabary,
                       const Script* script = nullptr,
                       uint32_t dict_file_checksum = 0,
-                      uint32_t schema_file_checksum = 0);
+                      uint32_t schema_file_checksum = 0,
+                      const vector<prism::Weight>* syllable_weights = nullptr);
 
   RIME_DLL bool HasKey(const string& key);
   RIME_DLL bool GetValue(const string& key, int* value) const;
   RIME_DLL void CommonPrefixSearch(const string& key, vector<Match>* result);
+  // common prefix search at every position of the key, done lazily.
+  RIME_DLL void CommonPrefixSearchAll(const string& key, MatchTable* result);
+  // keys are returned in breadth-first order of the trie, shortest first.
   RIME_DLL void ExpandSearch(const string& key,
                              vector<Match>* result,
                              size_t limit);
+  // with the completion index, the best `limit` keys are returned best first;
+  // otherwise the same as ExpandSearch.
+  RIME_DLL void TopKExpandSearch(const string& key,
+                                 vector<Match>* result,
+                                 size_t limit);
   SpellingAccessor QuerySpelling(SyllableId spelling_id);
 
   RIME_DLL size_t array_size() const;
 
   uint32_t dict_file_checksum() const;
   uint32_t schema_file_checksum() const;
+  bool has_completion_index() const { return node_weights_ != nullptr; }
   Darts::DoubleArray& trie() const { return *trie_; }
 
  protected:
+  bool BuildCompletionIndex(const vector<prism::Weight>& syllable_weights,
+                            const vector<const char*>& keys);
+  void BestFirstExpandSearch(const string& key,
+                             size_t node_pos,
+                             vector<Match>* result,
+                             size_t limit);
+
   the<Darts::DoubleArray> trie_;
   prism::Metadata* metadata_ = nullptr;
   prism::SpellingMap* spelling_map_ = nullptr;
+  prism::WeightMap* key_weights_ = nullptr;
+  prism::WeightMap* node_weights_ = nullptr;
   double format_ = 0.0;
 };
 
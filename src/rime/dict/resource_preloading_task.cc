@@ -0,0 +1,98 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <mutex>
+#include <rime/schema.h>
+#include <rime/ticket.h>
+#include <rime/dict/dictionary.h>
+#include <rime/dict/prism.h>
+#include <rime/dict/resource_preloading_task.h>
+#include <rime/dict/table.h>
+#include <rime/dict/user_dictionary.h>
+
+namespace rime {
+
+static std::mutex pinned_mutex;
+static vector<of<Dictionary>> pinned_dictionaries;
+static vector<of<UserDictionary>> pinned_user_dictionaries;
+
+ResourcePreloadingTask::ResourcePreloadingTask(TaskInitializer arg, bool pin)
+    : pin_(pin) {
+  try {
+    auto schema_ids = std::any_cast<vector<string>>(arg);
+    for (const auto& schema_id : schema_ids) {
+      AddResources(schema_id);
+    }
+  } catch (const std::bad_any_cast&) {
+    LOG(ERROR) << "ResourcePreloadingTask: invalid arguments.";
+  }
+}
+
+void ResourcePreloadingTask::AddResources(const string& schema_id) {
+  Schema schema(schema_id);
+  Config* config = schema.config();
+  if (!config) {
+    LOG(ERROR) << "schema '" << schema_id << "' not found.";
+    return;
+  }
+  auto dictionary_component = Dictionary::Require("dictionary");
+  auto user_dictionary_component = UserDictionary::Require("user_dictionary");
+  set<string> name_spaces;
+  for (const string component_type : {"translator", "filter"}) {
+    auto list = config->GetList("engine/" + component_type + "s");
+    if (!list)
+      continue;
+    for (size_t i = 0; i < list->size(); ++i) {
+      auto prescription = list->GetValueAt(i);
+      if (!prescription)
+        continue;
+      Ticket ticket(nullptr, component_type, prescription->str());
+      ticket.schema = &schema;
+      if (!config->IsValue(ticket.name_space + "/dictionary") ||
+          !name_spaces.insert(ticket.name_space).second)
+        continue;
+      if (dictionary_component) {
+        if (an<Dictionary> dictionary{dictionary_component->Create(ticket)})
+          dictionaries_.push_back(dictionary);
+      }
+      if (user_dictionary_component) {
+        if (an<UserDictionary> user_dictionary{
+                user_dictionary_component->Create(ticket)})
+          user_dictionaries_.push_back(user_dictionary);
+      }
+    }
+  }
+}
+
+bool ResourcePreloadingTask::Run(Deployer* deployer) {
+  bool success = true;
+  for (const auto& dictionary : dictionaries_) {
+    if (!dictionary->Load()) {
+      success = false;
+      continue;
+    }
+    dictionary->prism()->WarmUp();
+    for (const auto& table : dictionary->tables()) {
+      if (table->IsOpen())
+        table->WarmUp();
+    }
+  }
+  for (const auto& user_dictionary : user_dictionaries_) {
+    if (!user_dictionary->Load())
+      success = false;
+  }
+  LOG(INFO) << "preloaded " << dictionaries_.size() << " dictionaries and "
+            << user_dictionaries_.size() << " user dictionaries.";
+  if (pin_) {
+    std::lock_guard<std::mutex> lock(pinned_mutex);
+    pinned_dictionaries.swap(dictionaries_);
+    pinned_user_dictionaries.swap(user_dictionaries_);
+  }
+  // previously pinned ones, if any, are released here.
+  dictionaries_.clear();
+  user_dictionaries_.clear();
+  return success;
+}
+
+}  // namespace rime
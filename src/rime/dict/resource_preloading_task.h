@@ -0,0 +1,52 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#ifndef RIME_RESOURCE_PRELOADING_TASK_H_
+#define RIME_RESOURCE_PRELOADING_TASK_H_
+
+#include <rime/common.h>
+#include <rime/deployer.h>
+
+namespace rime {
+
+class Dictionary;
+class UserDictionary;
+
+// Loads the dictionaries and user dictionaries used by a list of schemas,
+// and reads their mapped files ahead, so that the first session of a schema
+// does not stall on cold page faults. The resources are created from the
+// schemas when the task is scheduled; loading happens in Run().
+class ResourcePreloadingTask : public DeploymentTask {
+ public:
+  // arg: vector<string> of schema ids
+  ResourcePreloadingTask(TaskInitializer arg, bool pin);
+  bool Run(Deployer* deployer);
+
+ protected:
+  void AddResources(const string& schema_id);
+
+  bool pin_;
+  vector<of<Dictionary>> dictionaries_;
+  vector<of<UserDictionary>> user_dictionaries_;
+};
+
+// preload_resources: loads and warms up the resources, which are released
+// when the last session using them closes.
+// pin_resources: also keeps them loaded until they are pinned again; pinning
+// an empty list releases those pinned.
+class ResourcePreloadingTaskComponent
+    : public ResourcePreloadingTask::Component {
+ public:
+  explicit ResourcePreloadingTaskComponent(bool pin) : pin_(pin) {}
+  ResourcePreloadingTask* Create(TaskInitializer arg) {
+    return new ResourcePreloadingTask(arg, pin_);
+  }
+
+ private:
+  bool pin_;
+};
+
+}  // namespace rime
+
+#endif  // RIME_RESOURCE_PRELOADING_TASK_H_
@@ -5,18 +5,32 @@
 // 2011-07-02 GONG Chen <chen.sst@gmail.com>
 //
 #include <cfloat>
+#include <cmath>
 #include <cstring>
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <utility>
+#include <utf8.h>
 #include <rime/common.h>
 #include <rime/algo/syllabifier.h>
 #include <rime/dict/table.h>
 
 namespace rime {
 
-const char kTableFormatLatest[] = "Rime::Table/4.0";
-const int kTableFormatLowestCompatible = 4.0;
+namespace table {
+
+void Entry::set_weight(double weight) {
+  double quantized = std::round(weight * kWeightScale);
+  quantized_weight = static_cast<Weight>(
+      std::clamp(quantized, double(std::numeric_limits<Weight>::min()),
+                 double(std::numeric_limits<Weight>::max())));
+}
+
+}  // namespace table
+
+const char kTableFormatLatest[] = "Rime::Table/5.1";
+const double kTableFormatLowestCompatible = 5.1;
 
 const char kTableFormatPrefix[] = "Rime::Table/";
 const size_t kTableFormatPrefixLen = sizeof(kTableFormatPrefix) - 1;
@@ -236,13 +250,26 @@ bool Table::AddString(const string& src,
   return true;
 }
 
+bool Table::AddString(const string& src, table::Entry* dest, double weight) {
+  size_t offset = reinterpret_cast<char*>(dest) - address();
+  entry_text_ids_.emplace_back(offset, kInvalidStringId);
+  string_table_builder_->Add(src, weight, &entry_text_ids_.back().second);
+  return true;
+}
+
 bool Table::OnBuildStart() {
   string_table_builder_.reset(new StringTableBuilder);
+  entry_text_ids_.clear();
   return true;
 }
 
 bool Table::OnBuildFinish() {
   string_table_builder_->Build();
+  for (const auto& x : entry_text_ids_) {
+    reinterpret_cast<table::Entry*>(address() + x.first)
+        ->set_text_id(x.second);
+  }
+  decltype(entry_text_ids_)().swap(entry_text_ids_);
   // saving string table image
   size_t image_size = string_table_builder_->BinarySize();
   char* image = Allocate<char>(image_size);
@@ -523,12 +550,15 @@ bool Table::BuildEntryList(const ShortDictEntryList& src,
 bool Table::BuildEntry(const ShortDictEntry& dict_entry, table::Entry* entry) {
   if (!entry)
     return false;
-  if (!AddString(dict_entry.text, &entry->text, dict_entry.weight)) {
+  if (!AddString(dict_entry.text, entry, dict_entry.weight)) {
     LOG(ERROR) << "Error creating table entry '" << dict_entry.text
                << "'; file size: " << file_size();
     return false;
   }
-  entry->weight = static_cast<table::Weight>(dict_entry.weight);
+  entry->set_weight(dict_entry.weight);
+  const string& text = dict_entry.text;
+  entry->set_single_char(utf8::unchecked::distance(
+                             text.c_str(), text.c_str() + text.length()) == 1);
   return true;
 }
 
@@ -630,7 +660,7 @@ bool Table::Query(const SyllableGraph& syll_graph,
 }
 
 string Table::GetEntryText(const table::Entry& entry) {
-  return GetString(entry.text);
+  return string_table_->GetString(entry.text_id());
 }
 
 }  // namespace rime
@@ -9,6 +9,7 @@
 #define RIME_TABLE_H_
 
 #include <cstring>
+#include <deque>
 #include <rime/common.h>
 #include <rime/dict/mapped_file.h>
 #include <rime/dict/vocabulary.h>
@@ -45,11 +46,37 @@ using Syllabary = Array<StringType>;
 
 using Code = List<SyllableId>;
 
-using Weight = float;
+// v5: log-scale weights are quantized to 16 bits, in steps of 1/1024.
+using Weight = int16_t;
 
+const double kWeightScale = 1024.0;
+
+// 6 bytes, 2-byte aligned. the string id is split into halves so that entries
+// pack densely in arrays.
+// v5.1: the top bit of text_hi marks an entry of a single character, so that
+// lookups by text length need not decode the text.
 struct Entry {
-  StringType text;
-  Weight weight;
+  static const uint16_t kSingleCharBit = 0x8000;
+
+  uint16_t text_lo = 0;
+  uint16_t text_hi = 0;
+  Weight quantized_weight = 0;
+
+  StringId text_id() const {
+    return static_cast<StringId>(text_hi & ~kSingleCharBit) << 16 | text_lo;
+  }
+  void set_text_id(StringId id) {
+    text_lo = static_cast<uint16_t>(id & 0xffff);
+    text_hi = static_cast<uint16_t>((text_hi & kSingleCharBit) |
+                                    ((id >> 16) & ~kSingleCharBit));
+  }
+  bool single_char() const { return (text_hi & kSingleCharBit) != 0; }
+  void set_single_char(bool single_char) {
+    text_hi = single_char ? (text_hi | kSingleCharBit)
+                          : (text_hi & ~kSingleCharBit);
+  }
+  double weight() const { return quantized_weight / kWeightScale; }
+  void set_weight(double weight);
 };
 
 struct LongEntry {
@@ -229,6 +256,7 @@ class Table : public MappedFile {
 
   string GetString(const table::StringType& x);
   bool AddString(const string& src, table::StringType* dest, double weight);
+  bool AddString(const string& src, table::Entry* dest, double weight);
   bool OnBuildStart();
   bool OnBuildFinish();
   bool OnLoad();
@@ -240,6 +268,9 @@ class Table : public MappedFile {
 
   the<StringTable> string_table_;
   the<StringTableBuilder> string_table_builder_;
+  // string ids of entries are known only after the string table is built;
+  // entries are located by offset as the file may be remapped while growing.
+  std::deque<pair<size_t, StringId>> entry_text_ids_;
 };
 
 }  // namespace rime
@@ -4,7 +4,12 @@
 //
 // 2013-04-18 GONG Chen <chen.sst@gmail.com>
 //
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <boost/algorithm/string.hpp>
+#include <rime/service.h>
+#include <rime/algo/utilities.h>
 #include <rime/dict/table_db.h>
 #include <rime/dict/user_db.h>
 
@@ -63,8 +68,160 @@ const TextFormat TableDb::format = {
 TableDb::TableDb(const path& file_path, const string& db_name)
     : TextDb(file_path, db_name, "tabledb", TableDb::format) {}
 
+// StableDbImage members
+
+const char kStableDbFormat[] = "Rime::StableDb/1.0";
+
+StableDbImage::StableDbImage(const path& file_path) : MappedFile(file_path) {}
+
+bool StableDbImage::Load() {
+  if (IsOpen())
+    Close();
+  if (!OpenReadOnly()) {
+    LOG(ERROR) << "Error opening stabledb image '" << file_path() << "'.";
+    return false;
+  }
+  metadata_ = Find<stable::Metadata>(0);
+  if (!metadata_ || strncmp(metadata_->format, kStableDbFormat,
+                            stable::Metadata::kFormatMaxLength)) {
+    LOG(ERROR) << "invalid stabledb image: " << file_path();
+    metadata_ = nullptr;
+    Close();
+    return false;
+  }
+  return true;
+}
+
+static size_t estimate_data_size(const TextDbData& data) {
+  size_t size = data.size() * sizeof(stable::Record);
+  for (const auto& x : data) {
+    size += x.first.length() + x.second.length() + 2;
+  }
+  return size;
+}
+
+bool StableDbImage::Build(const TextDbData& metadata,
+                          const TextDbData& data,
+                          uint32_t text_file_checksum) {
+  // records should fit in the file without growing it, which would move the
+  // mapped region.
+  const size_t kReservedSize = 1024;
+  size_t estimated_size = kReservedSize + sizeof(stable::Metadata) +
+                          estimate_data_size(metadata) +
+                          estimate_data_size(data);
+  if (!Create(estimated_size)) {
+    LOG(ERROR) << "Error creating stabledb image '" << file_path() << "'.";
+    return false;
+  }
+  metadata_ = Allocate<stable::Metadata>();
+  if (!metadata_) {
+    LOG(ERROR) << "Error creating metadata in file '" << file_path() << "'.";
+    return false;
+  }
+  metadata_->text_file_checksum = text_file_checksum;
+  if (!CopyRecords(metadata, &metadata_->metadata) ||
+      !CopyRecords(data, &metadata_->records)) {
+    LOG(ERROR) << "Error saving records in file '" << file_path() << "'.";
+    return false;
+  }
+  std::strncpy(metadata_->format, kStableDbFormat,
+               stable::Metadata::kFormatMaxLength);
+  return true;
+}
+
+bool StableDbImage::CopyRecords(const TextDbData& data,
+                                List<stable::Record>* records) {
+  if (data.empty())
+    return true;
+  auto array = Allocate<stable::Record>(data.size());
+  if (!array)
+    return false;
+  size_t i = 0;
+  // already sorted by key
+  for (const auto& x : data) {
+    if (!CopyString(x.first, &array[i].key) ||
+        !CopyString(x.second, &array[i].value))
+      return false;
+    ++i;
+  }
+  records->size = data.size();
+  records->at = array;
+  return true;
+}
+
+bool StableDbImage::Save() {
+  LOG(INFO) << "saving stabledb image: " << file_path();
+  return ShrinkToFit();
+}
+
+uint32_t StableDbImage::text_file_checksum() const {
+  return metadata_ ? metadata_->text_file_checksum : 0;
+}
+
+const List<stable::Record>* StableDbImage::metadata() const {
+  return metadata_ ? &metadata_->metadata : nullptr;
+}
+
+const List<stable::Record>* StableDbImage::records() const {
+  return metadata_ ? &metadata_->records : nullptr;
+}
+
+// StableDbAccessor members
+
+StableDbAccessor::StableDbAccessor(const List<stable::Record>* records,
+                                   const string& prefix)
+    : DbAccessor(prefix), records_(records) {
+  Reset();
+}
+
+const stable::Record* StableDbAccessor::LowerBound(const string& key) const {
+  return std::lower_bound(records_->begin(), records_->end(), key,
+                          [](const stable::Record& record, const string& key) {
+                            return strcmp(record.key.c_str(), key.c_str()) < 0;
+                          });
+}
+
+bool StableDbAccessor::Reset() {
+  iter_ = prefix_.empty() ? records_->begin() : LowerBound(prefix_);
+  return iter_ != records_->end();
+}
+
+bool StableDbAccessor::Jump(const string& key) {
+  iter_ = LowerBound(key);
+  return iter_ != records_->end();
+}
+
+bool StableDbAccessor::GetNextRecord(string* key, string* value) {
+  if (!key || !value || exhausted())
+    return false;
+  *key = iter_->key.c_str();
+  *value = iter_->value.c_str();
+  ++iter_;
+  return true;
+}
+
+bool StableDbAccessor::exhausted() {
+  return iter_ == records_->end() || !MatchesPrefix(iter_->key.c_str());
+}
+
+static bool fetch_record(const List<stable::Record>* records,
+                         const string& key,
+                         string* value) {
+  StableDbAccessor accessor(records, key);
+  string record_key;
+  string record_value;
+  if (!accessor.GetNextRecord(&record_key, &record_value) || record_key != key)
+    return false;
+  *value = record_value;
+  return true;
+}
+
+// StableDb members
+
 StableDb::StableDb(const path& file_path, const string& db_name)
-    : TableDb(file_path, db_name) {}
+    : TableDb(file_path, db_name),
+      image_path_(Service::instance().deployer().staging_dir /
+                  (db_name + ".stabledb.bin")) {}
 
 bool StableDb::Open() {
   if (loaded())
@@ -73,7 +230,92 @@ bool StableDb::Open() {
     LOG(INFO) << "stabledb '" << name() << "' does not exist.";
     return false;
   }
-  return TableDb::OpenReadOnly();
+  return OpenReadOnly();
+}
+
+bool StableDb::OpenReadOnly() {
+  if (loaded())
+    return false;
+  if (!Exists())
+    return TableDb::OpenReadOnly();
+  uint32_t text_file_checksum = Checksum(file_path());
+  if (LoadImage(text_file_checksum))
+    return true;
+  // (re)compile the text file; use the text data if it fails.
+  if (!TableDb::OpenReadOnly())
+    return false;
+  LOG(INFO) << "compiling stabledb '" << name() << "'.";
+  std::error_code ec;
+  if (image_path_.has_parent_path()) {
+    std::filesystem::create_directories(image_path_.parent_path(), ec);
+  }
+  StableDbImage image(image_path_);
+  bool success = false;
+  try {
+    success = image.Build(metadata_, data_, text_file_checksum) && image.Save();
+  } catch (const std::exception& ex) {
+    LOG(ERROR) << ex.what();
+  }
+  if (!success) {
+    LOG(ERROR) << "Error compiling stabledb '" << name() << "'.";
+    image.Remove();
+    return true;
+  }
+  image.Close();
+  if (LoadImage(text_file_checksum)) {
+    // free the text data
+    Clear();
+  }
+  return true;
+}
+
+bool StableDb::LoadImage(uint32_t text_file_checksum) {
+  the<StableDbImage> image(new StableDbImage(image_path_));
+  if (!image->Exists() || !image->Load() ||
+      image->text_file_checksum() != text_file_checksum) {
+    return false;
+  }
+  image_ = std::move(image);
+  loaded_ = true;
+  readonly_ = true;
+  return true;
+}
+
+bool StableDb::Close() {
+  if (!image_)
+    return TableDb::Close();
+  image_.reset();
+  loaded_ = false;
+  readonly_ = false;
+  return true;
+}
+
+bool StableDb::MetaFetch(const string& key, string* value) {
+  if (!image_)
+    return TableDb::MetaFetch(key, value);
+  if (!value || !loaded())
+    return false;
+  return fetch_record(image_->metadata(), key, value);
+}
+
+an<DbAccessor> StableDb::QueryMetadata() {
+  if (!image_)
+    return TableDb::QueryMetadata();
+  return New<StableDbAccessor>(image_->metadata(), "");
+}
+
+an<DbAccessor> StableDb::Query(const string& key) {
+  if (!image_)
+    return TableDb::Query(key);
+  return New<StableDbAccessor>(image_->records(), key);
+}
+
+bool StableDb::Fetch(const string& key, string* value) {
+  if (!image_)
+    return TableDb::Fetch(key, value);
+  if (!value || !loaded())
+    return false;
+  return fetch_record(image_->records(), key, value);
 }
 
 template <>
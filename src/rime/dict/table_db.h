@@ -7,10 +7,67 @@
 #ifndef RIME_TABLE_DB_H_
 #define RIME_TABLE_DB_H_
 
+#include <stdint.h>
+#include <rime/dict/mapped_file.h>
 #include <rime/dict/text_db.h>
 
 namespace rime {
 
+namespace stable {
+
+struct Record {
+  String key;
+  String value;
+};
+
+struct Metadata {
+  static const int kFormatMaxLength = 32;
+  char format[kFormatMaxLength];
+  uint32_t text_file_checksum;
+  List<Record> metadata;
+  // sorted by key
+  List<Record> records;
+};
+
+}  // namespace stable
+
+// compiled image of a stabledb text file, mapped into memory at runtime.
+class StableDbImage : public MappedFile {
+ public:
+  explicit StableDbImage(const path& file_path);
+
+  bool Load();
+  bool Build(const TextDbData& metadata,
+             const TextDbData& data,
+             uint32_t text_file_checksum);
+  bool Save();
+
+  uint32_t text_file_checksum() const;
+  const List<stable::Record>* metadata() const;
+  const List<stable::Record>* records() const;
+
+ private:
+  bool CopyRecords(const TextDbData& data, List<stable::Record>* records);
+
+  stable::Metadata* metadata_ = nullptr;
+};
+
+class StableDbAccessor : public DbAccessor {
+ public:
+  StableDbAccessor(const List<stable::Record>* records, const string& prefix);
+
+  virtual bool Reset();
+  virtual bool Jump(const string& key);
+  virtual bool GetNextRecord(string* key, string* value);
+  virtual bool exhausted();
+
+ private:
+  const stable::Record* LowerBound(const string& key) const;
+
+  const List<stable::Record>* records_;
+  const stable::Record* iter_;
+};
+
 class TableDb : public TextDb {
  public:
   TableDb(const path& file_path, const string& db_name);
@@ -18,12 +75,28 @@ class TableDb : public TextDb {
   static const TextFormat format;
 };
 
-// read-only tabledb
+// read-only tabledb. the text file is compiled into an image on first open,
+// and again whenever its checksum changes.
 class StableDb : public TableDb {
  public:
   StableDb(const path& file_path, const string& db_name);
 
-  virtual bool Open();
+  bool Open() override;
+  bool OpenReadOnly() override;
+  bool Close() override;
+
+  bool MetaFetch(const string& key, string* value) override;
+  an<DbAccessor> QueryMetadata() override;
+  an<DbAccessor> Query(const string& key) override;
+  bool Fetch(const string& key, string* value) override;
+
+  const path& image_path() const { return image_path_; }
+
+ private:
+  bool LoadImage(uint32_t text_file_checksum);
+
+  path image_path_;
+  the<StableDbImage> image_;
 };
 
 }  // namespace rime
@@ -10,6 +10,7 @@
 #include <boost/algorithm/string.hpp>
 #include <rime/service.h>
 #include <rime/algo/dynamics.h>
+#include <rime/algo/strings.h>
 #include <rime/dict/text_db.h>
 #include <rime/dict/user_db.h>
 
@@ -116,7 +117,7 @@ bool UserDbHelper::UniformBackup(const path& snapshot_file) {
   LOG(INFO) << "backing up userdb '" << db_->name() << "' to " << snapshot_file;
   TsvWriter writer(snapshot_file, plain_userdb_format.formatter);
   writer.file_description = plain_userdb_format.file_description;
-  DbSource source(db_);
+  UserDbSource source(db_);
   try {
     writer << source;
   } catch (std::exception& ex) {
@@ -137,7 +138,7 @@ bool UserDbHelper::UniformRestore(const path& snapshot_file) {
     LOG(ERROR) << ex.what();
     return false;
   }
-  return true;
+  return sink.Flush();
 }
 
 bool UserDbHelper::IsUserDb() {
@@ -180,7 +181,188 @@ static TickCount get_tick_count(Db* db) {
   return 1;
 }
 
-UserDbMerger::UserDbMerger(Db* db) : db_(db) {
+// UserDbSyllabary members
+
+static const char* kKeyEncodingKey = "/key_encoding";
+static const char* kSyllableIdEncoding = "syllable_id";
+static const char* kSyllablesKey = "/syllables";
+
+// ids are written in digits from '0' to '~', avoiding ' ' and '#', which
+// starts a comment line in text files.
+static const char kIdDigitZero = '0';
+static const size_t kIdRadix = '~' - '0' + 1;
+static const size_t kMaxSyllableIds = kIdRadix * kIdRadix * kIdRadix;
+
+static string format_syllable_id(size_t id) {
+  string result(UserDbSyllabary::kIdLength, kIdDigitZero);
+  for (size_t i = UserDbSyllabary::kIdLength; i-- > 0; id /= kIdRadix) {
+    result[i] = char(kIdDigitZero + id % kIdRadix);
+  }
+  return result;
+}
+
+static bool parse_syllable_id(const string& key, size_t pos, size_t* id) {
+  *id = 0;
+  for (size_t i = pos; i < pos + UserDbSyllabary::kIdLength; ++i) {
+    if (key[i] < kIdDigitZero || key[i] > '~')
+      return false;
+    *id = *id * kIdRadix + (key[i] - kIdDigitZero);
+  }
+  return true;
+}
+
+bool UserDbSyllabary::Load() {
+  string encoding;
+  loaded_ = db_->MetaFetch(kKeyEncodingKey, &encoding) &&
+            encoding == kSyllableIdEncoding;
+  syllables_.clear();
+  ids_.clear();
+  if (!loaded_)
+    return false;
+  string syllables;
+  if (db_->MetaFetch(kSyllablesKey, &syllables)) {
+    syllables_ =
+        strings::split(syllables, " ", strings::SplitBehavior::SkipToken);
+  }
+  for (size_t i = 0; i < syllables_.size(); ++i) {
+    ids_[syllables_[i]] = format_syllable_id(i);
+  }
+  return true;
+}
+
+bool UserDbSyllabary::Save() {
+  try {
+    return db_->MetaUpdate(kSyllablesKey, strings::join(syllables_, " ")) &&
+           db_->MetaUpdate(kKeyEncodingKey, kSyllableIdEncoding);
+  } catch (...) {
+    return false;
+  }
+}
+
+bool UserDbSyllabary::Add(const vector<string>& syllables) {
+  size_t last_size = syllables_.size();
+  for (const string& syllable : syllables) {
+    if (syllable.empty() || ids_.find(syllable) != ids_.end())
+      continue;
+    if (syllables_.size() >= kMaxSyllableIds) {
+      LOG(ERROR) << "too many syllables in user db '" << db_->name() << "'.";
+      break;
+    }
+    ids_[syllable] = format_syllable_id(syllables_.size());
+    syllables_.push_back(syllable);
+  }
+  if (syllables_.size() == last_size)
+    return true;
+  if (!Save()) {
+    LOG(ERROR) << "failed to save syllable ids of '" << db_->name() << "'.";
+    // the ids are not to be used unless saved
+    Load();
+    return false;
+  }
+  return true;
+}
+
+bool UserDbSyllabary::EncodeKeys(const vector<string>& known_syllables) {
+  if (loaded_)
+    return Add(known_syllables);
+  LOG(INFO) << "coding keys of user db '" << db_->name()
+            << "' with syllable ids.";
+  vector<pair<string, string>> records;
+  // ids are first assigned in alphabetical order
+  set<string> syllables(known_syllables.begin(), known_syllables.end());
+  if (auto accessor = db_->QueryAll()) {
+    string key, value;
+    while (accessor->GetNextRecord(&key, &value)) {
+      size_t tab = key.find('\t');
+      if (tab == string::npos)
+        continue;
+      for (const auto& s : strings::split(key.substr(0, tab), " ",
+                                          strings::SplitBehavior::SkipToken)) {
+        syllables.insert(s);
+      }
+      records.push_back({key, value});
+    }
+  }
+  auto* transactional = dynamic_cast<Transactional*>(db_);
+  bool in_batch = transactional && !transactional->in_transaction() &&
+                  transactional->BeginTransaction();
+  loaded_ = true;
+  bool success = Add(vector<string>(syllables.begin(), syllables.end())) &&
+                 Save();
+  for (auto it = records.begin(); success && it != records.end(); ++it) {
+    string key;
+    if (!EncodeKey(it->first, &key)) {
+      LOG(WARNING) << "invalid key in user db: " << it->first;
+      continue;
+    }
+    success = db_->Erase(it->first) && db_->Update(key, it->second);
+  }
+  if (in_batch) {
+    if (success)
+      success = transactional->CommitTransaction();
+    else
+      transactional->AbortTransaction();
+  }
+  if (!success) {
+    LOG(ERROR) << "failed to code keys of user db '" << db_->name() << "'.";
+    Load();
+  }
+  return success;
+}
+
+bool UserDbSyllabary::EncodeKey(const string& key, string* result, bool add) {
+  size_t tab = key.find('\t');
+  if (!loaded_ || tab == string::npos)
+    return false;
+  auto syllables = strings::split(key.substr(0, tab), " ",
+                                  strings::SplitBehavior::SkipToken);
+  if (add && !Add(syllables))
+    return false;
+  string encoded;
+  encoded.reserve(syllables.size() * (kIdLength + 1) + key.length() - tab);
+  for (const string& syllable : syllables) {
+    const string& id = GetId(syllable);
+    if (id.empty())
+      return false;
+    encoded.append(id) += ' ';
+  }
+  encoded.append(key, tab, string::npos);
+  result->swap(encoded);
+  return true;
+}
+
+bool UserDbSyllabary::DecodeKey(const string& key, string* result) {
+  size_t tab = key.find('\t');
+  if (!loaded_ || tab == string::npos)
+    return false;
+  result->clear();
+  for (size_t pos = 0; pos < tab; pos += kIdLength + 1) {
+    size_t id = 0;
+    if (pos + kIdLength >= tab || key[pos + kIdLength] != ' ' ||
+        !parse_syllable_id(key, pos, &id))
+      return false;
+    if (id >= syllables_.size()) {
+      // may have been assigned through another db object
+      Load();
+      if (id >= syllables_.size())
+        return false;
+    }
+    result->append(syllables_[id]) += ' ';
+  }
+  result->append(key, tab, string::npos);
+  return true;
+}
+
+const string& UserDbSyllabary::GetId(const string& syllable) const {
+  static const string kNotFound;
+  auto found = ids_.find(syllable);
+  return found != ids_.end() ? found->second : kNotFound;
+}
+
+// UserDbMerger members
+
+UserDbMerger::UserDbMerger(Db* db) : DbSink(db), syllabary_(db) {
+  syllabary_.Load();
   our_tick_ = get_tick_count(db);
   their_tick_ = 0;
   max_tick_ = our_tick_;
@@ -204,15 +386,21 @@ bool UserDbMerger::MetaPut(const string& key, const string& value) {
 bool UserDbMerger::Put(const string& key, const string& value) {
   if (!db_)
     return false;
+  string db_key(key);
+  if (syllabary_.loaded() && !syllabary_.EncodeKey(key, &db_key, true))
+    return false;
   UserDbValue v(value);
   if (v.tick < their_tick_) {
     v.dee = algo::formula_d(0, (double)their_tick_, v.dee, (double)v.tick);
   }
   UserDbValue o;
   string our_value;
-  if (db_->Fetch(key, &our_value)) {
+  if (Fetch(db_key, &our_value)) {
     o.Unpack(our_value);
   }
+  if (merged_keys_ && o.tick <= local_since_) {
+    merged_keys_->insert(key);
+  }
   if (o.tick < our_tick_) {
     o.dee = algo::formula_d(0, (double)our_tick_, o.dee, (double)o.tick);
   }
@@ -220,7 +408,7 @@ bool UserDbMerger::Put(const string& key, const string& value) {
     o.commits = v.commits;
   o.dee = (std::max)(o.dee, v.dee);
   o.tick = max_tick_;
-  return db_->Update(key, o.Pack()) && ++merged_entries_;
+  return Update(db_key, o.Pack()) && ++merged_entries_;
 }
 
 void UserDbMerger::CloseMerge() {
@@ -228,18 +416,22 @@ void UserDbMerger::CloseMerge() {
     return;
   Deployer& deployer(Service::instance().deployer());
   try {
-    db_->MetaUpdate("/tick", std::to_string(max_tick_));
-    db_->MetaUpdate("/user_id", deployer.user_id);
+    MetaUpdate("/tick", std::to_string(max_tick_));
+    MetaUpdate("/user_id", deployer.user_id);
   } catch (...) {
     LOG(ERROR) << "failed to update tick count.";
     return;
   }
+  // commit the last batch of entries along with the tick count
+  Flush();
   LOG(INFO) << "total " << merged_entries_
             << " entries merged, tick = " << max_tick_;
   merged_entries_ = 0;
 }
 
-UserDbImporter::UserDbImporter(Db* db) : db_(db) {}
+UserDbImporter::UserDbImporter(Db* db) : DbSink(db), syllabary_(db) {
+  syllabary_.Load();
+}
 
 bool UserDbImporter::MetaPut(const string& key, const string& value) {
   return true;
@@ -248,10 +440,13 @@ bool UserDbImporter::MetaPut(const string& key, const string& value) {
 bool UserDbImporter::Put(const string& key, const string& value) {
   if (!db_)
     return false;
+  string db_key(key);
+  if (syllabary_.loaded() && !syllabary_.EncodeKey(key, &db_key, true))
+    return false;
   UserDbValue v(value);
   UserDbValue o;
   string old_value;
-  if (db_->Fetch(key, &old_value)) {
+  if (Fetch(db_key, &old_value)) {
     o.Unpack(old_value);
   }
   if (v.commits > 0) {
@@ -260,7 +455,36 @@ bool UserDbImporter::Put(const string& key, const string& value) {
   } else if (v.commits < 0) {  // mark as deleted
     o.commits = (std::min)(v.commits, -std::abs(o.commits));
   }
-  return db_->Update(key, o.Pack());
+  return Update(db_key, o.Pack());
+}
+
+// UserDbSource members
+
+UserDbSource::UserDbSource(Db* db) : DbSource(db), syllabary_(db) {
+  syllabary_.Load();
+}
+
+bool UserDbSource::MetaGet(string* key, string* value) {
+  while (DbSource::MetaGet(key, value)) {
+    // snapshots have spelled keys
+    if (*key != kKeyEncodingKey && *key != kSyllablesKey)
+      return true;
+  }
+  return false;
+}
+
+bool UserDbSource::Get(string* key, string* value) {
+  while (DbSource::Get(key, value)) {
+    if (!syllabary_.loaded())
+      return true;
+    string spelled;
+    if (syllabary_.DecodeKey(*key, &spelled)) {
+      key->swap(spelled);
+      return true;
+    }
+    LOG(WARNING) << "invalid key in user db: " << *key;
+  }
+  return false;
 }
 
 }  // namespace rime
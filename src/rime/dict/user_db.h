@@ -75,6 +75,46 @@ class UserDbHelper {
   Db* db_;
 };
 
+/**
+ * Syllable ids of a user db which codes its keys with them instead of
+ * spelled syllables, as chosen by the user dict.
+ *
+ * key ::= (id <space>)+ <Tab> phrase, where id is of kIdLength characters.
+ *
+ * Ids are assigned by the user db and saved in its metadata, so they stay
+ * valid when dictionaries are rebuilt. Snapshots have spelled keys.
+ */
+class UserDbSyllabary {
+ public:
+  static const size_t kIdLength = 3;
+
+  explicit UserDbSyllabary(Db* db) : db_(db) {}
+
+  /// Reads the saved ids; returns false if the db has spelled keys.
+  RIME_DLL bool Load();
+  /// Assigns ids to the syllables not having one, and saves them.
+  RIME_DLL bool Add(const vector<string>& syllables);
+  /// Converts the spelled keys in the db to syllable ids, assigning ids to
+  /// the given syllables as well.
+  RIME_DLL bool EncodeKeys(const vector<string>& known_syllables);
+  /// Translates a key with spelled syllables. New syllables are assigned ids
+  /// if add is true; otherwise they fail the translation.
+  RIME_DLL bool EncodeKey(const string& key, string* result, bool add = false);
+  RIME_DLL bool DecodeKey(const string& key, string* result);
+  /// Returns the id of a syllable as written in keys, or an empty string.
+  RIME_DLL const string& GetId(const string& syllable) const;
+
+  bool loaded() const { return loaded_; }
+
+ protected:
+  bool Save();
+
+  Db* db_;
+  bool loaded_ = false;
+  vector<string> syllables_;
+  hash_map<string, string> ids_;
+};
+
 /// A template to define a user db class based on an implementation of rime::Db.
 template <class BaseDb>
 class UserDbWrapper : public BaseDb {
@@ -108,7 +148,7 @@ class UserDbComponent : public UserDb::Component, protected DbComponentBase {
   string extension() const override;
 };
 
-class UserDbMerger : public Sink {
+class UserDbMerger : public DbSink {
  public:
   explicit UserDbMerger(Db* db);
   virtual ~UserDbMerger();
@@ -117,16 +157,23 @@ class UserDbMerger : public Sink {
   virtual bool Put(const string& key, const string& value);
 
   void CloseMerge();
+  // records in *keys the merged entries not updated here after local_since.
+  void RecordMergedKeys(TickCount local_since, set<string>* keys) {
+    local_since_ = local_since;
+    merged_keys_ = keys;
+  }
 
  protected:
-  Db* db_;
   TickCount our_tick_;
   TickCount their_tick_;
   TickCount max_tick_;
-  int merged_entries_;
+  int merged_entries_ = 0;
+  TickCount local_since_ = 0;
+  set<string>* merged_keys_ = nullptr;
+  UserDbSyllabary syllabary_;
 };
 
-class UserDbImporter : public Sink {
+class UserDbImporter : public DbSink {
  public:
   explicit UserDbImporter(Db* db);
 
@@ -134,7 +181,19 @@ class UserDbImporter : public Sink {
   virtual bool Put(const string& key, const string& value);
 
  protected:
-  Db* db_;
+  UserDbSyllabary syllabary_;
+};
+
+/// Reads user db records with spelled keys, whatever the key encoding.
+class UserDbSource : public DbSource {
+ public:
+  RIME_DLL explicit UserDbSource(Db* db);
+
+  virtual bool MetaGet(string* key, string* value);
+  virtual bool Get(string* key, string* value);
+
+ protected:
+  UserDbSyllabary syllabary_;
 };
 
 }  // namespace rime
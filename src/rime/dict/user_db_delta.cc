@@ -0,0 +1,229 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <boost/crc.hpp>
+#include <rime/dict/db_utils.h>
+#include <rime/dict/user_db_delta.h>
+
+namespace rime {
+
+static const char kDeltaFormat[] = "Rime::UserDbDelta/1.0";
+
+static void put_varint(string* buffer, uint64_t x) {
+  while (x >= 0x80) {
+    buffer->push_back(char((x & 0x7f) | 0x80));
+    x >>= 7;
+  }
+  buffer->push_back(char(x));
+}
+
+static bool get_varint(const char** p, const char* end, uint64_t* x) {
+  *x = 0;
+  for (int shift = 0; shift < 64 && *p < end; shift += 7) {
+    uint64_t byte = (unsigned char)*(*p)++;
+    *x |= (byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+static void put_string(string* buffer, const string& s) {
+  put_varint(buffer, s.length());
+  buffer->append(s);
+}
+
+static bool get_string(const char** p, const char* end, string* s) {
+  uint64_t length = 0;
+  if (!get_varint(p, end, &length) || uint64_t(end - *p) < length)
+    return false;
+  s->assign(*p, length);
+  *p += length;
+  return true;
+}
+
+static void put_double(string* buffer, double x) {
+  uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    buffer->push_back(char(bits >> (i * 8)));
+  }
+}
+
+static bool get_double(const char** p, const char* end, double* x) {
+  if (end - *p < 8)
+    return false;
+  uint64_t bits = 0;
+  for (int i = 0; i < 8; ++i) {
+    bits |= uint64_t((unsigned char)*(*p)++) << (i * 8);
+  }
+  std::memcpy(x, &bits, sizeof(bits));
+  return true;
+}
+
+static bool get_header(const char** p,
+                       const char* end,
+                       UserDbDeltaHeader* header) {
+  const size_t format_length = sizeof(kDeltaFormat);
+  if (size_t(end - *p) < format_length ||
+      std::memcmp(*p, kDeltaFormat, format_length) != 0)
+    return false;
+  *p += format_length;
+  return get_varint(p, end, &header->since_tick) &&
+         get_varint(p, end, &header->tick);
+}
+
+int UserDbDeltaWriter::operator()(Source* source) {
+  if (!source)
+    return -1;
+  LOG(INFO) << "writing user db delta: " << file_path_;
+  string buffer(kDeltaFormat, sizeof(kDeltaFormat));
+  put_varint(&buffer, since_tick_);
+  TickCount tick = 0;
+  string key, value;
+  vector<pair<string, string>> metadata;
+  while (source->MetaGet(&key, &value)) {
+    if (key == "/tick") {
+      try {
+        tick = std::stoul(value);
+      } catch (...) {
+      }
+    }
+    metadata.push_back({key, value});
+  }
+  put_varint(&buffer, tick);
+  put_varint(&buffer, metadata.size());
+  for (const auto& kv : metadata) {
+    put_string(&buffer, kv.first);
+    put_string(&buffer, kv.second);
+  }
+  // entries are prefix compressed against the previous key
+  int num_entries = 0;
+  string last_key;
+  while (source->Get(&key, &value)) {
+    if (key.empty())
+      continue;
+    UserDbValue v(value);
+    if (v.tick < since_tick_ || (excluded_until_ && v.tick <= excluded_until_) ||
+        (excluded_keys_ && excluded_keys_->count(key)))
+      continue;
+    size_t shared = 0;
+    while (shared < last_key.length() && shared < key.length() &&
+           last_key[shared] == key[shared])
+      ++shared;
+    put_varint(&buffer, shared);
+    put_string(&buffer, key.substr(shared));
+    // zigzag encoding for negative commits, which mark deleted entries
+    put_varint(&buffer, (uint64_t(int64_t(v.commits)) << 1) ^
+                            uint64_t(int64_t(v.commits) >> 63));
+    put_double(&buffer, v.dee);
+    put_varint(&buffer, v.tick);
+    last_key.swap(key);
+    ++num_entries;
+  }
+  // end of entries
+  put_varint(&buffer, 0);
+  put_varint(&buffer, 0);
+  boost::crc_32_type crc;
+  crc.process_bytes(buffer.data(), buffer.length());
+  uint32_t checksum = crc.checksum();
+  for (int i = 0; i < 4; ++i) {
+    buffer.push_back(char(checksum >> (i * 8)));
+  }
+  // write to a temporary file first, lest readers see a partial file
+  path temp_path(file_path_);
+  temp_path += ".tmp";
+  {
+    std::ofstream fout(temp_path.c_str(), std::ios::binary);
+    fout.write(buffer.data(), buffer.length());
+    if (!fout) {
+      LOG(ERROR) << "error writing file: " << temp_path;
+      return -1;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, file_path_, ec);
+  if (ec) {
+    LOG(ERROR) << "error renaming " << temp_path << ": " << ec.message();
+    return -1;
+  }
+  DLOG(INFO) << num_entries << " entries since tick " << since_tick_;
+  return num_entries;
+}
+
+bool UserDbDeltaReader::ReadHeader(UserDbDeltaHeader* header) {
+  if (!header)
+    return false;
+  std::ifstream fin(file_path_.c_str(), std::ios::binary);
+  char buffer[sizeof(kDeltaFormat) + 20];
+  fin.read(buffer, sizeof(buffer));
+  const char* p = buffer;
+  return get_header(&p, buffer + fin.gcount(), header);
+}
+
+int UserDbDeltaReader::operator()(Sink* sink) {
+  if (!sink)
+    return 0;
+  LOG(INFO) << "reading user db delta: " << file_path_;
+  std::ifstream fin(file_path_.c_str(), std::ios::binary);
+  string buffer((std::istreambuf_iterator<char>(fin)),
+                std::istreambuf_iterator<char>());
+  fin.close();
+  if (buffer.length() < sizeof(kDeltaFormat) + 4) {
+    LOG(ERROR) << "invalid user db delta: " << file_path_;
+    return -1;
+  }
+  const char* p = buffer.data();
+  const char* end = p + buffer.length() - 4;
+  uint32_t checksum = 0;
+  for (int i = 0; i < 4; ++i) {
+    checksum |= uint32_t((unsigned char)end[i]) << (i * 8);
+  }
+  boost::crc_32_type crc;
+  crc.process_bytes(p, end - p);
+  UserDbDeltaHeader header;
+  uint64_t num_metadata = 0;
+  if (crc.checksum() != checksum || !get_header(&p, end, &header) ||
+      !get_varint(&p, end, &num_metadata)) {
+    LOG(ERROR) << "damaged user db delta: " << file_path_;
+    return -1;
+  }
+  string key, value;
+  for (uint64_t i = 0; i < num_metadata; ++i) {
+    if (!get_string(&p, end, &key) || !get_string(&p, end, &value)) {
+      LOG(ERROR) << "damaged user db delta: " << file_path_;
+      return -1;
+    }
+    sink->MetaPut(key, value);
+  }
+  int num_entries = 0;
+  key.clear();
+  string suffix;
+  while (p < end) {
+    uint64_t shared = 0;
+    if (!get_varint(&p, end, &shared) || !get_string(&p, end, &suffix) ||
+        shared > key.length())
+      break;
+    if (shared == 0 && suffix.empty())
+      return num_entries;  // end of entries
+    key.resize(shared);
+    key += suffix;
+    uint64_t zigzag = 0;
+    UserDbValue v;
+    if (!get_varint(&p, end, &zigzag) || !get_double(&p, end, &v.dee) ||
+        !get_varint(&p, end, &v.tick))
+      break;
+    v.commits = int(int64_t(zigzag >> 1) ^ -int64_t(zigzag & 1));
+    if (sink->Put(key, v.Pack()))
+      ++num_entries;
+  }
+  LOG(ERROR) << "damaged user db delta: " << file_path_;
+  return -1;
+}
+
+}  // namespace rime
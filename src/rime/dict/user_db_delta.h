@@ -0,0 +1,74 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#ifndef RIME_USER_DB_DELTA_H_
+#define RIME_USER_DB_DELTA_H_
+
+#include <rime/common.h>
+#include <rime/dict/user_db.h>
+
+namespace rime {
+
+class Sink;
+class Source;
+
+// A binary snapshot of user db entries updated since a given tick.
+//
+// Layout: format string, since tick, tick, metadata, prefix-compressed
+// entries in key order, and a CRC-32 of all the preceding bytes.
+struct UserDbDeltaHeader {
+  // changes since since_tick are included
+  TickCount since_tick = 0;
+  // tick count of the user db at the time of writing
+  TickCount tick = 0;
+};
+
+class UserDbDeltaWriter {
+ public:
+  UserDbDeltaWriter(const path& file_path, TickCount since_tick)
+      : file_path_(file_path), since_tick_(since_tick) {}
+  // skips entries stamped with ticks up to until_tick, eg. those sent or
+  // merged in earlier syncs, and entries of the given keys, eg. those just
+  // merged from other devices.
+  void Exclude(TickCount until_tick, const set<string>* keys) {
+    excluded_until_ = until_tick;
+    excluded_keys_ = keys;
+  }
+  // return number of records written, -1 on failure
+  RIME_DLL int operator()(Source* source);
+
+ protected:
+  path file_path_;
+  TickCount since_tick_;
+  TickCount excluded_until_ = 0;
+  const set<string>* excluded_keys_ = nullptr;
+};
+
+class UserDbDeltaReader {
+ public:
+  explicit UserDbDeltaReader(const path& file_path) : file_path_(file_path) {}
+  // read the header only
+  RIME_DLL bool ReadHeader(UserDbDeltaHeader* header);
+  // return number of records read, -1 if the file is damaged
+  RIME_DLL int operator()(Sink* sink);
+
+  static string extension() { return ".delta"; }
+
+ protected:
+  path file_path_;
+};
+
+template <class SourceType>
+int operator<<(UserDbDeltaWriter& writer, SourceType& source) {
+  return writer(&source);
+}
+
+template <class SinkType>
+int operator>>(UserDbDeltaReader& reader, SinkType& sink) {
+  return reader(&sink);
+}
+
+}  // namespace rime
+
+#endif  // RIME_USER_DB_DELTA_H_
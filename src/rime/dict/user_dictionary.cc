@@ -18,6 +18,7 @@
 #include <rime/algo/syllabifier.h>
 #include <rime/algo/strings.h>
 #include <rime/dict/db.h>
+#include <rime/dict/level_db.h>
 #include <rime/dict/table.h>
 #include <rime/dict/user_dictionary.h>
 #include <rime/dict/vocabulary.h>
@@ -33,13 +34,16 @@ struct DfsState {
   vector<double> quality_len;
   hash_map<int, DictEntryList> query_result;
   an<DbAccessor> accessor;
+  // set if keys are coded with syllable ids
+  UserDbSyllabary* key_syllabary = nullptr;
   string key;
   string value;
 
   size_t depth() const { return code.size(); }
 
   bool IsExactMatch(const string& prefix) {
-    return boost::starts_with(key, prefix + '\t');
+    return key.length() > prefix.length() && key[prefix.length()] == '\t' &&
+           key.compare(0, prefix.length(), prefix) == 0;
   }
   bool IsPrefixMatch(const string& prefix) {
     return boost::starts_with(key, prefix);
@@ -72,16 +76,23 @@ struct DfsState {
 
 void DfsState::RecruitEntry(size_t pos,
                             hash_map<string, SyllableId>* syllabary) {
+  string spelled_key;
+  if (key_syllabary && !key_syllabary->DecodeKey(key, &spelled_key)) {
+    LOG(WARNING) << "invalid key in user db: " << key;
+    return;
+  }
   string full_code;
   auto e = UserDictionary::CreateDictEntry(
-      key, value, present_tick, credibility.back(), quality_len.back(),
-      syllabary ? &full_code : nullptr);
+      key_syllabary ? spelled_key : key, value, present_tick,
+      credibility.back(), quality_len.back(), syllabary ? &full_code : nullptr);
   if (e) {
     if (syllabary) {
       vector<string> syllables =
           strings::split(full_code, " ", strings::SplitBehavior::SkipToken);
-      Code numeric_code;
-      for (auto s = syllables.begin(); s != syllables.end(); ++s) {
+      // the leading syllables are those of the prefix being looked up
+      Code numeric_code(code);
+      for (auto s = syllables.begin() + std::min(code.size(), syllables.size());
+           s != syllables.end(); ++s) {
         auto found = syllabary->find(*s);
         if (found == syllabary->end()) {
           LOG(ERROR) << "failed to recruit dict entry '" << e->text
@@ -150,23 +161,93 @@ bool UserDictEntryIterator::Next() {
   return true;
 }
 
+// merges updates not yet written into the records of the db, in key order.
+class PendingUpdateAccessor : public DbAccessor {
+ public:
+  PendingUpdateAccessor(const string& prefix,
+                        an<DbAccessor> db_accessor,
+                        map<string, string>&& pending)
+      : DbAccessor(prefix),
+        db_accessor_(db_accessor),
+        pending_(std::move(pending)) {
+    Reset();
+  }
+
+  bool Reset() override {
+    bool ok = db_accessor_->Reset();
+    next_ = pending_.begin();
+    FetchDbRecord();
+    return ok || next_ != pending_.end();
+  }
+  bool Jump(const string& key) override {
+    bool ok = db_accessor_->Jump(key);
+    next_ = pending_.lower_bound(key);
+    FetchDbRecord();
+    return ok || next_ != pending_.end();
+  }
+  bool GetNextRecord(string* key, string* value) override {
+    if (!key || !value || exhausted())
+      return false;
+    if (next_ != pending_.end() &&
+        (!has_db_record_ || next_->first <= db_key_)) {
+      if (has_db_record_ && next_->first == db_key_)
+        FetchDbRecord();  // superseded
+      *key = next_->first;
+      *value = next_->second;
+      ++next_;
+    } else {
+      *key = db_key_;
+      *value = db_value_;
+      FetchDbRecord();
+    }
+    return true;
+  }
+  bool exhausted() override {
+    return !has_db_record_ && next_ == pending_.end();
+  }
+
+ private:
+  void FetchDbRecord() {
+    has_db_record_ = db_accessor_->GetNextRecord(&db_key_, &db_value_);
+  }
+
+  an<DbAccessor> db_accessor_;
+  // all keys in the prefix
+  map<string, string> pending_;
+  map<string, string>::const_iterator next_;
+  bool has_db_record_ = false;
+  string db_key_;
+  string db_value_;
+};
+
 // UserDictionary members
 
-UserDictionary::UserDictionary(const string& name, an<Db> db)
-    : name_(name), db_(db) {}
+UserDictionary::UserDictionary(const string& name,
+                               an<Db> db,
+                               an<UserDbSyllabary> key_syllabary)
+    : name_(name),
+      db_(db),
+      key_syllabary_(key_syllabary ? key_syllabary
+                                   : New<UserDbSyllabary>(db.get())) {}
 
 UserDictionary::~UserDictionary() {
   if (loaded()) {
     CommitPendingTransaction();
   }
+  WaitForLearning();
 }
 
 void UserDictionary::Attach(const an<Table>& table, const an<Prism>& prism) {
   table_ = table;
   prism_ = prism;
+  if (loaded())
+    LoadKeySyllabary();
 }
 
 bool UserDictionary::Load() {
+  // dbs are shared, and may be opened in the background by preloading.
+  static std::mutex load_mutex;
+  std::lock_guard<std::mutex> lock(load_mutex);
   if (!db_ || db_->disabled())
     return false;
   if (!db_->loaded() && !db_->Open()) {
@@ -179,7 +260,28 @@ bool UserDictionary::Load() {
     }
     return false;
   }
-  return FetchTickCount() || Initialize();
+  if (!FetchTickCount() && !Initialize())
+    return false;
+  if (table_)
+    LoadKeySyllabary();
+  return true;
+}
+
+// keys are coded with syllable ids if the db does so, or is asked to.
+bool UserDictionary::LoadKeySyllabary() {
+  auto lock = LockDb();
+  if (!key_syllabary_->Load() && !syllable_id_keys_)
+    return true;  // spelled keys
+  Syllabary syllabary;
+  if (!table_ || !table_->GetSyllabary(&syllabary)) {
+    LOG(ERROR) << "failed to get syllabary for user dict: " << name();
+    return false;
+  }
+  if (readonly())
+    return key_syllabary_->loaded();
+  // ids are assigned to syllables new to the db
+  return key_syllabary_->EncodeKeys(
+      vector<string>(syllabary.begin(), syllabary.end()));
 }
 
 bool UserDictionary::loaded() const {
@@ -222,8 +324,24 @@ void UserDictionary::DfsLookup(const SyllableGraph& syll_graph,
     return;
   }
   DLOG(INFO) << "dfs lookup starts from " << current_pos;
-  string prefix;
+  // syllables are visited in the order of their keys in the db, which can
+  // differ from that of syllable ids in the table if keys are coded with
+  // syllable ids of the db.
+  vector<pair<string, const SpellingIndex::value_type*>> syllables;
+  syllables.reserve(index->second.size());
   for (const auto& spelling : index->second) {
+    string syllable = GetKeySyllable(spelling.first);
+    if (!syllable.empty())
+      syllables.push_back({std::move(syllable), &spelling});
+  }
+  if (state->key_syllabary) {
+    std::sort(syllables.begin(), syllables.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+  }
+  string prefix;
+  prefix.reserve(current_prefix.length() + 8);
+  for (const auto& x : syllables) {
+    const auto& spelling = *x.second;
     DLOG(INFO) << "prefix: '" << current_prefix << "'"
                << ", syll_id: " << spelling.first
                << ", num_spellings: " << spelling.second.size();
@@ -232,8 +350,8 @@ void UserDictionary::DfsLookup(const SyllableGraph& syll_graph,
       state->code.pop_back();
     }
     BOOST_SCOPE_EXIT_END
-    if (!TranslateCodeToString(state->code, &prefix))
-      continue;
+    // extend the prefix by one syllable rather than translating the code
+    prefix.assign(current_prefix).append(x.first) += ' ';
     for (size_t i = 0; i < spelling.second.size(); ++i) {
       auto props = spelling.second[i];
       if (i > 0 && props->type >= kAbbreviation)
@@ -302,11 +420,30 @@ void UserDictionary::DfsLookup(const SyllableGraph& syll_graph,
   }
 }
 
-static an<UserDictEntryCollector> collect(
-    hash_map<int, DictEntryList>* source) {
+static an<UserDictEntryCollector> collect(hash_map<int, DictEntryList>* source,
+                                         bool predict_word) {
+  if (source->empty())
+    return nullptr;
   auto result = New<UserDictEntryCollector>();
   for (auto& x : *source) {
-    (*result)[x.first].SetEntries(std::move(x.second));
+    // sort each group of homophones by weight
+    auto& entries = x.second;
+    entries.Sort();
+    if (predict_word) {
+      if (!entries.empty() && entries.front()->IsPredictiveMatch()) {
+        DLOG(INFO) << "front entry is predictive match: "
+                   << entries.front()->text;
+        auto found =
+            std::find_if(entries.begin(), entries.end(),
+                         [](const auto& e) { return e->IsExactMatch(); });
+        if (found != entries.end()) {
+          DLOG(INFO) << "rotating exact match entry to front: "
+                     << (*found)->text;
+          std::rotate(entries.begin(), found, found + 1);
+        }
+      }
+    }
+    (*result)[x.first].SetEntries(std::move(entries));
   }
   return result;
 }
@@ -320,6 +457,7 @@ an<UserDictEntryCollector> UserDictionary::Lookup(
   if (!table_ || !prism_ || !loaded() ||
       start_pos >= syll_graph.interpreted_length)
     return nullptr;
+  auto lock = LockDb();
   DfsState state;
   state.depth_limit = depth_limit;
   state.predict_word_from_depth = predict_word_from_depth;
@@ -327,32 +465,47 @@ an<UserDictEntryCollector> UserDictionary::Lookup(
   state.present_tick = tick_ + 1;
   state.credibility.push_back(initial_credibility);
   state.quality_len.push_back(0.0);
-  state.accessor = db_->Query("");
+  state.accessor = Query("");
   state.accessor->Jump(" ");  // skip metadata
+  if (key_syllabary_->loaded())
+    state.key_syllabary = key_syllabary_.get();
   string prefix;
   DfsLookup(syll_graph, start_pos, prefix, &state);
-  if (state.query_result.empty())
-    return nullptr;
-  // sort each group of homophones by weight
-  for (auto& v : state.query_result) {
-    auto& entries = v.second;
-    entries.Sort();
-    if (state.predict_word_from_depth) {
-      if (!entries.empty() && entries.front()->IsPredictiveMatch()) {
-        DLOG(INFO) << "front entry is predictive match: "
-                   << entries.front()->text;
-        auto found =
-            std::find_if(entries.begin(), entries.end(),
-                         [](const auto& e) { return e->IsExactMatch(); });
-        if (found != entries.end()) {
-          DLOG(INFO) << "rotating exact match entry to front: "
-                     << (*found)->text;
-          std::rotate(entries.begin(), found, found + 1);
-        }
-      }
+  return collect(&state.query_result, state.predict_word_from_depth != 0);
+}
+
+UserDictEntryCollectors UserDictionary::LookupAll(
+    const SyllableGraph& syll_graph,
+    size_t depth_limit,
+    double initial_credibility) {
+  UserDictEntryCollectors result;
+  if (!table_ || !prism_ || !loaded())
+    return result;
+  auto lock = LockDb();
+  DfsState state;
+  state.depth_limit = depth_limit;
+  state.predict_word_from_depth = 0;
+  FetchTickCount();
+  state.present_tick = tick_ + 1;
+  state.credibility.push_back(initial_credibility);
+  state.quality_len.push_back(0.0);
+  state.accessor = Query("");
+  state.accessor->Jump(" ");  // skip metadata
+  if (key_syllabary_->loaded())
+    state.key_syllabary = key_syllabary_.get();
+  string prefix;
+  for (const auto& x : syll_graph.edges) {
+    size_t start_pos = x.first;
+    if (start_pos >= syll_graph.interpreted_length)
+      break;
+    // each search seeks to its first syllable; the cursor is reused.
+    DfsLookup(syll_graph, start_pos, prefix, &state);
+    if (auto collector = collect(&state.query_result, false)) {
+      result[start_pos] = collector;
     }
+    state.query_result.clear();
   }
-  return collect(&state.query_result);
+  return result;
 }
 
 size_t UserDictionary::LookupWords(UserDictEntryIterator* result,
@@ -360,6 +513,12 @@ size_t UserDictionary::LookupWords(UserDictEntryIterator* result,
                                    bool predictive,
                                    size_t limit,
                                    string* resume_key) {
+  auto lock = LockDb();
+  if (key_syllabary_->loaded()) {
+    LOG(ERROR) << "user dict '" << name_
+               << "' with syllable id keys cannot be looked up by code.";
+    return 0;
+  }
   TickCount present_tick = tick_ + 1;
   size_t len = input.length();
   size_t start = result->cache_size();
@@ -369,7 +528,7 @@ size_t UserDictionary::LookupWords(UserDictEntryIterator* result,
   string key;
   string value;
   string full_code;
-  auto accessor = db_->Query(input);
+  auto accessor = Query(input);
   if (!accessor || accessor->exhausted()) {
     if (resume_key)
       *resume_key = kEnd;
@@ -430,20 +589,75 @@ bool UserDictionary::UpdateEntry(const DictEntry& entry,
     return false;
   string key(code_str + '\t' + entry.text);
   string value;
+  if (!db_lock_) {
+    if (!MakeUpdate(&key, commits, new_entry_prefix, &value))
+      return false;
+    if (commits > 0)
+      SaveTickCount();
+    return db_->Update(key, value);
+  }
+  {
+    auto lock = LockDb();
+    if (!MakeUpdate(&key, commits, new_entry_prefix, &value))
+      return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    uint64_t serial = ++last_serial_;
+    pending_.push_back({serial, transaction_, key, value});
+    if (commits > 0) {
+      queue_.push_back({LearningRecord::kUpdateTickCount, string(),
+                        std::to_string(tick_), serial});
+    }
+    queue_.push_back({LearningRecord::kUpdate, key, value, serial});
+  }
+  StartLearning();
+  return true;
+}
+
+bool UserDictionary::FetchLatest(const string& key, string* value) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    for (auto it = pending_.rbegin(); it != pending_.rend(); ++it) {
+      if (it->key == key) {
+        *value = it->value;
+        return true;
+      }
+    }
+  }
+  return db_->Fetch(key, value);
+}
+
+// works out the db key and the new value of an entry, advancing the tick
+// count on commits.
+bool UserDictionary::MakeUpdate(string* key,
+                                int commits,
+                                const string& new_entry_prefix,
+                                string* value) {
+  if (key_syllabary_->loaded()) {
+    string encoded;
+    if (!new_entry_prefix.empty() ||
+        !key_syllabary_->EncodeKey(*key, &encoded)) {
+      LOG(ERROR) << "failed to code key with syllable ids: " << *key;
+      return false;
+    }
+    key->swap(encoded);
+  }
+  string latest;
   UserDbValue v;
-  if (db_->Fetch(key, &value)) {
-    v.Unpack(value);
+  if (FetchLatest(*key, &latest)) {
+    v.Unpack(latest);
     if (v.tick > tick_) {
       v.tick = tick_;  // fix abnormal timestamp
     }
   } else if (!new_entry_prefix.empty()) {
-    key.insert(0, new_entry_prefix);
+    key->insert(0, new_entry_prefix);
   }
   if (commits > 0) {
     if (v.commits < 0)
       v.commits = -v.commits;  // revive a deleted item
     v.commits += commits;
-    UpdateTickCount(1);
+    ++tick_;
     v.dee = algo::formula_d(commits, (double)tick_, v.dee, (double)v.tick);
   } else if (commits == 0) {
     const double k = 0.1;
@@ -453,11 +667,25 @@ bool UserDictionary::UpdateEntry(const DictEntry& entry,
     v.dee = algo::formula_d(0.0, (double)tick_, v.dee, (double)v.tick);
   }
   v.tick = tick_;
-  return db_->Update(key, v.Pack());
+  *value = v.Pack();
+  return true;
 }
 
 bool UserDictionary::UpdateTickCount(TickCount increment) {
   tick_ += increment;
+  if (!db_lock_) {
+    return SaveTickCount();
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.push_back({LearningRecord::kUpdateTickCount, string(),
+                      std::to_string(tick_), last_serial_});
+  }
+  StartLearning();
+  return true;
+}
+
+bool UserDictionary::SaveTickCount() {
   try {
     return db_->MetaUpdate("/tick", std::to_string(tick_));
   } catch (...) {
@@ -465,6 +693,110 @@ bool UserDictionary::UpdateTickCount(TickCount increment) {
   }
 }
 
+// from now on, transaction_ tells if the db is in a transaction once the
+// queued writes are done.
+void UserDictionary::EnableAsyncLearning(an<std::mutex> db_lock) {
+  WaitForLearning();
+  db_lock_ = db_lock;
+  auto db = As<Transactional>(db_);
+  transaction_ = db && db->in_transaction() ? ++last_transaction_ : 0;
+}
+
+void UserDictionary::WaitForLearning() const {
+  if (learner_.valid())
+    learner_.wait();
+}
+
+void UserDictionary::StartLearning() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (learning_ || queue_.empty())
+      return;
+    learning_ = true;
+  }
+  learner_ = std::async(std::launch::async, [this] { Learn(); });
+}
+
+// runs on the worker thread until the queue is empty. the db is locked for
+// one write at a time, so that lookups wait for little. updates leave
+// pending_ once they are in the db for good.
+void UserDictionary::Learn() {
+  auto db = As<Transactional>(db_);
+  while (true) {
+    vector<LearningRecord> records;
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      if (queue_.empty()) {
+        learning_ = false;
+        return;
+      }
+      records.swap(queue_);
+    }
+    for (const auto& record : records) {
+      uint64_t written = 0;
+      {
+        auto lock = LockDb();
+        switch (record.action) {
+          case LearningRecord::kUpdate:
+            if (!db_->Update(record.key, record.value)) {
+              LOG(ERROR) << "error updating user dict '" << name_ << "'.";
+            } else if (!db || !db->in_transaction()) {
+              written = record.serial;
+            }
+            break;
+          case LearningRecord::kUpdateTickCount:
+            try {
+              db_->MetaUpdate("/tick", record.value);
+            } catch (...) {
+              LOG(ERROR) << "error updating tick count of '" << name_ << "'.";
+            }
+            break;
+          case LearningRecord::kBeginTransaction:
+            if (db)
+              db->BeginTransaction();
+            break;
+          case LearningRecord::kCommitTransaction:
+            if (db && db->CommitTransaction())
+              written = record.serial;
+            break;
+          case LearningRecord::kAbortTransaction:
+            if (db)
+              db->AbortTransaction();
+            break;
+        }
+      }
+      if (written) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        while (!pending_.empty() && pending_.front().serial <= written)
+          pending_.pop_front();
+      }
+    }
+  }
+}
+
+std::unique_lock<std::mutex> UserDictionary::LockDb() const {
+  return db_lock_ ? std::unique_lock<std::mutex>(*db_lock_)
+                  : std::unique_lock<std::mutex>();
+}
+
+// the db records under the key prefix, along with updates not yet written.
+an<DbAccessor> UserDictionary::Query(const string& key) {
+  auto accessor = db_->Query(key);
+  if (!db_lock_ || !accessor)
+    return accessor;
+  map<string, string> pending;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    for (const auto& update : pending_) {
+      if (boost::starts_with(update.key, key))
+        pending[update.key] = update.value;
+    }
+  }
+  if (pending.empty())
+    return accessor;
+  return New<PendingUpdateAccessor>(key, accessor, std::move(pending));
+}
+
 bool UserDictionary::Initialize() {
   return db_->MetaUpdate("/tick", "0");
 }
@@ -475,7 +807,9 @@ bool UserDictionary::FetchTickCount() {
     // an earlier version mistakenly wrote tick count into an empty key
     if (!db_->MetaFetch("/tick", &value) && !db_->Fetch("", &value))
       return false;
-    tick_ = std::stoul(value);
+    TickCount tick = std::stoul(value);
+    // the saved tick count may lag behind updates still being written
+    tick_ = db_lock_ ? (std::max)(tick_, tick) : tick;
     return true;
   } catch (...) {
     // tick_ = 0;
@@ -489,12 +823,42 @@ bool UserDictionary::NewTransaction() {
     return false;
   CommitPendingTransaction();
   transaction_time_ = time(NULL);
+  if (db_lock_) {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      transaction_ = ++last_transaction_;
+      queue_.push_back({LearningRecord::kBeginTransaction, string(), string(),
+                        last_serial_});
+    }
+    StartLearning();
+    return true;
+  }
   return db->BeginTransaction();
 }
 
 bool UserDictionary::RevertRecentTransaction() {
   auto db = As<Transactional>(db_);
-  if (!db || !db->in_transaction())
+  if (!db)
+    return false;
+  if (db_lock_) {
+    if (!transaction_ || time(NULL) - transaction_time_ > 3 /*seconds*/)
+      return false;
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+                                    [this](const PendingUpdate& update) {
+                                      return update.transaction ==
+                                             transaction_;
+                                    }),
+                     pending_.end());
+      transaction_ = 0;
+      queue_.push_back({LearningRecord::kAbortTransaction, string(), string(),
+                        last_serial_});
+    }
+    StartLearning();
+    return true;
+  }
+  if (!db->in_transaction())
     return false;
   if (time(NULL) - transaction_time_ > 3 /*seconds*/)
     return false;
@@ -503,23 +867,52 @@ bool UserDictionary::RevertRecentTransaction() {
 
 bool UserDictionary::CommitPendingTransaction() {
   auto db = As<Transactional>(db_);
-  if (db && db->in_transaction()) {
+  if (!db)
+    return false;
+  if (db_lock_) {
+    if (!transaction_)
+      return false;
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      transaction_ = 0;
+      queue_.push_back({LearningRecord::kCommitTransaction, string(), string(),
+                        last_serial_});
+    }
+    StartLearning();
+    return true;
+  }
+  if (db->in_transaction()) {
     return db->CommitTransaction();
   }
   return false;
 }
 
+string UserDictionary::GetKeySyllable(SyllableId syllable_id) {
+  const string& spelling = GetSyllable(syllable_id);
+  if (spelling.empty() || !key_syllabary_->loaded())
+    return spelling;
+  return key_syllabary_->GetId(spelling);
+}
+
+const string& UserDictionary::GetSyllable(SyllableId syllable_id) {
+  auto found = rev_syllabary_.find(syllable_id);
+  if (found != rev_syllabary_.end())
+    return found->second;
+  const string& spelling = rev_syllabary_[syllable_id] =
+      table_->GetSyllableById(syllable_id);
+  if (spelling.empty()) {
+    LOG(ERROR) << "Error translating syllable_id '" << syllable_id << "'.";
+  }
+  return spelling;
+}
+
 bool UserDictionary::TranslateCodeToString(const Code& code, string* result) {
   if (!table_ || !result)
     return false;
   result->clear();
   for (const SyllableId& syllable_id : code) {
-    string spelling = rev_syllabary_.count(syllable_id)
-                          ? rev_syllabary_[syllable_id]
-                          : (rev_syllabary_[syllable_id] =
-                                 table_->GetSyllableById(syllable_id));
+    const string& spelling = GetSyllable(syllable_id);
     if (spelling.empty()) {
-      LOG(ERROR) << "Error translating syllable_id '" << syllable_id << "'.";
       result->clear();
       return false;
     }
@@ -573,6 +966,13 @@ UserDictionaryComponent::UserDictionaryComponent() {}
 UserDictionary* UserDictionaryComponent::Create(const string& dict_name,
                                                 const string& db_class) {
   auto db = db_pool_[dict_name].lock();
+  auto key_syllabary = key_syllabary_pool_[dict_name].lock();
+  if (!db_options_loaded_) {
+    // by now default.yaml has been deployed; user dictionaries are created
+    // on the main thread, unlike dbs, which may be opened on the deployer's.
+    LevelDb::LoadOptions("userdb");
+    db_options_loaded_ = true;
+  }
   if (!db) {
     auto component = Db::Require(db_class);
     if (!component) {
@@ -581,8 +981,13 @@ UserDictionary* UserDictionaryComponent::Create(const string& dict_name,
     }
     db.reset(component->Create(dict_name));
     db_pool_[dict_name] = db;
+    key_syllabary.reset();
   }
-  return new UserDictionary(dict_name, db);
+  if (!key_syllabary) {
+    key_syllabary = New<UserDbSyllabary>(db.get());
+    key_syllabary_pool_[dict_name] = key_syllabary;
+  }
+  return new UserDictionary(dict_name, db, key_syllabary);
 }
 
 UserDictionary* UserDictionaryComponent::Create(const Ticket& ticket) {
@@ -609,7 +1014,36 @@ UserDictionary* UserDictionaryComponent::Create(const Ticket& ticket) {
     // user specified db class
   }
   // obtain userdb object
-  return Create(dict_name, db_class);
+  auto user_dict = Create(dict_name, db_class);
+  string key_encoding;
+  if (user_dict &&
+      config->GetString(ticket.name_space + "/user_dict_key_encoding",
+                        &key_encoding)) {
+    if (key_encoding != "syllable_id") {
+      user_dict->set_syllable_id_keys(false);
+    } else if (ticket.klass == "table_translator") {
+      // table translators look up user words by code, which is not possible
+      // once the keys are spelled with syllable ids.
+      LOG(ERROR) << ticket.name_space << "/user_dict_key_encoding: "
+                 << key_encoding << " is not supported by " << ticket.klass
+                 << "; keeping spelled keys.";
+    } else {
+      user_dict->set_syllable_id_keys(true);
+    }
+  }
+  // opt-in: learning from commits is moved off the key path, for a db that
+  // can be read from one thread while written to from another.
+  bool async_learning = false;
+  config->GetBool(ticket.name_space + "/async_learning", &async_learning);
+  if (user_dict && async_learning) {
+    auto db_lock = db_lock_pool_[dict_name].lock();
+    if (!db_lock) {
+      db_lock = New<std::mutex>();
+      db_lock_pool_[dict_name] = db_lock;
+    }
+    user_dict->EnableAsyncLearning(db_lock);
+  }
+  return user_dict;
 }
 
 }  // namespace rime
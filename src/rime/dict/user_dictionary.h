@@ -8,6 +8,9 @@
 #define RIME_USER_DICTIONARY_H_
 
 #include <time.h>
+#include <deque>
+#include <future>
+#include <mutex>
 #include <rime/common.h>
 #include <rime/component.h>
 #include <rime/dict/user_db.h>
@@ -37,6 +40,8 @@ class UserDictEntryIterator : public DictEntryFilterBinder {
 };
 
 using UserDictEntryCollector = map<size_t, UserDictEntryIterator>;
+// user phrases by start position, then by end position
+using UserDictEntryCollectors = map<size_t, an<UserDictEntryCollector>>;
 
 class Schema;
 class Table;
@@ -48,7 +53,10 @@ struct Ticket;
 
 class UserDictionary : public Class<UserDictionary, const Ticket&> {
  public:
-  UserDictionary(const string& name, an<Db> db);
+  // dictionaries sharing the db should share its key syllabary.
+  UserDictionary(const string& name,
+                 an<Db> db,
+                 an<UserDbSyllabary> key_syllabary = nullptr);
   virtual ~UserDictionary();
 
   void Attach(const an<Table>& table, const an<Prism>& prism);
@@ -61,6 +69,11 @@ class UserDictionary : public Class<UserDictionary, const Ticket&> {
                                     size_t depth_limit = 0,
                                     size_t predict_word_from_depth = 0,
                                     double initial_credibility = 0.0);
+  // looks up phrases starting at every vertex of the syllable graph, sharing
+  // one cursor into the db.
+  UserDictEntryCollectors LookupAll(const SyllableGraph& syllable_graph,
+                                    size_t depth_limit = 0,
+                                    double initial_credibility = 0.0);
   size_t LookupWords(UserDictEntryIterator* result,
                      const string& input,
                      bool predictive,
@@ -76,8 +89,19 @@ class UserDictionary : public Class<UserDictionary, const Ticket&> {
   bool RevertRecentTransaction();
   bool CommitPendingTransaction();
 
+  // queues the writes of UpdateEntry() and transactions for a worker thread,
+  // which takes db_lock while writing; dictionaries sharing the db should
+  // share the lock. lookups read updates not yet written from memory.
+  void EnableAsyncLearning(an<std::mutex> db_lock);
+  // waits until queued writes are done.
+  void WaitForLearning() const;
+
   const string& name() const { return name_; }
   TickCount tick() const { return tick_; }
+  // codes keys in the db with syllable ids once attached to a table. only
+  // dictionaries looked up by syllables, not by LookupWords(), can do so.
+  void set_syllable_id_keys(bool value) { syllable_id_keys_ = value; }
+  bool syllable_id_keys() const { return key_syllabary_->loaded(); }
 
   static an<DictEntry> CreateDictEntry(const string& key,
                                        const string& value,
@@ -90,6 +114,19 @@ class UserDictionary : public Class<UserDictionary, const Ticket&> {
   bool Initialize();
   bool FetchTickCount();
   bool TranslateCodeToString(const Code& code, string* result);
+  const string& GetSyllable(SyllableId syllable_id);
+  string GetKeySyllable(SyllableId syllable_id);
+  bool LoadKeySyllabary();
+  bool FetchLatest(const string& key, string* value);
+  bool MakeUpdate(string* key,
+                  int commits,
+                  const string& new_entry_prefix,
+                  string* value);
+  bool SaveTickCount();
+  an<DbAccessor> Query(const string& key);
+  void StartLearning();
+  void Learn();
+  std::unique_lock<std::mutex> LockDb() const;
   void DfsLookup(const SyllableGraph& syll_graph,
                  size_t current_pos,
                  const string& current_prefix,
@@ -104,6 +141,40 @@ class UserDictionary : public Class<UserDictionary, const Ticket&> {
   hash_map<SyllableId, string> rev_syllabary_;
   TickCount tick_ = 0;
   time_t transaction_time_ = 0;
+  an<UserDbSyllabary> key_syllabary_;
+  bool syllable_id_keys_ = false;
+
+  // a write queued for the worker, in the order made
+  struct LearningRecord {
+    enum Action {
+      kUpdate,
+      kUpdateTickCount,
+      kBeginTransaction,
+      kCommitTransaction,
+      kAbortTransaction,
+    };
+    Action action;
+    string key;
+    string value;
+    uint64_t serial;
+  };
+  // an update not yet written, or not yet committed
+  struct PendingUpdate {
+    uint64_t serial;
+    uint64_t transaction;
+    string key;
+    string value;
+  };
+  an<std::mutex> db_lock_;
+  std::mutex queue_mutex_;
+  vector<LearningRecord> queue_;
+  deque<PendingUpdate> pending_;
+  uint64_t last_serial_ = 0;
+  // the transaction open on the calling thread; 0 for none
+  uint64_t transaction_ = 0;
+  uint64_t last_transaction_ = 0;
+  bool learning_ = false;
+  mutable std::future<void> learner_;
 };
 
 class UserDictionaryComponent : public UserDictionary::Component {
@@ -114,6 +185,9 @@ class UserDictionaryComponent : public UserDictionary::Component {
 
  private:
   hash_map<string, weak<Db>> db_pool_;
+  hash_map<string, weak<UserDbSyllabary>> key_syllabary_pool_;
+  hash_map<string, weak<std::mutex>> db_lock_pool_;
+  bool db_options_loaded_ = false;
 };
 
 }  // namespace rime
@@ -4,7 +4,10 @@
 //
 // 2011-04-24 GONG Chen <chen.sst@gmail.com>
 //
+#include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <future>
 #include <rime/common.h>
 #include <rime/composition.h>
 #include <rime/context.h>
@@ -20,14 +23,18 @@
 #include <rime/switcher.h>
 #include <rime/switches.h>
 #include <rime/ticket.h>
+#include <rime/tracer.h>
 #include <rime/translation.h>
 #include <rime/translator.h>
 
 namespace rime {
 
+static const int kDefaultLatencyBudget = 20;  // ms
+
 class ConcreteEngine : public Engine {
  public:
   ConcreteEngine();
+  explicit ConcreteEngine(Schema* schema);
   virtual ~ConcreteEngine();
   virtual bool ProcessKey(const KeyEvent& key_event);
   virtual void ApplySchema(Schema* schema);
@@ -45,6 +52,34 @@ class ConcreteEngine : public Engine {
   void OnContextUpdate(Context* ctx);
   void OnOptionUpdate(Context* ctx, const string& option);
   void OnPropertyUpdate(Context* ctx, const string& property);
+  void PausePrefetch();
+  void ResumePrefetch();
+  void StopPrefetch();
+  void MergeLateTranslations();
+  void WaitForUserDictQueries();
+
+  // menus do not prefetch while the engine works with translators and
+  // filters, which are not thread-safe.
+  class PrefetchPause {
+   public:
+    explicit PrefetchPause(ConcreteEngine* engine) : engine_(engine) {
+      engine_->PausePrefetch();
+    }
+    ~PrefetchPause() { engine_->ResumePrefetch(); }
+
+   private:
+    ConcreteEngine* engine_;
+  };
+
+  // a query running on a worker thread. a result that misses the latency
+  // budget is merged into the menu it was made for on the next refresh, or
+  // else kept for the next translation of the same input.
+  struct PendingQuery {
+    std::future<an<Translation>> result;
+    string input;
+    size_t start = 0;
+    weak<Menu> menu;
+  };
 
   vector<of<Processor>> processors_;
   vector<of<Segmentor>> segmentors_;
@@ -53,6 +88,15 @@ class ConcreteEngine : public Engine {
   vector<of<Formatter>> formatters_;
   vector<of<Processor>> post_processors_;
   an<Switcher> switcher_;
+  // parallel to translators_
+  vector<bool> concurrent_;
+  vector<PendingQuery> pending_;
+  std::chrono::milliseconds latency_budget_{kDefaultLatencyBudget};
+  // the latest menu, which prepares candidates on a worker thread while the
+  // engine is idle. one at a time, since menus share translators.
+  weak<Menu> prefetching_;
+  size_t prefetch_count_ = 0;
+  int prefetch_paused_ = 0;
 };
 
 // implementations
@@ -61,20 +105,34 @@ Engine* Engine::Create() {
   return new ConcreteEngine;
 }
 
-Engine::Engine() : schema_(new Schema), context_(new Context) {}
+Engine* Engine::Create(Schema* schema) {
+  return new ConcreteEngine(schema);
+}
+
+Engine::Engine() : Engine(new Schema) {}
+
+Engine::Engine(Schema* schema)
+    : schema_(schema), context_(new Context), tracer_(New<Tracer>()) {}
 
 Engine::~Engine() {
   context_.reset();
   schema_.reset();
 }
 
-ConcreteEngine::ConcreteEngine() {
+ConcreteEngine::ConcreteEngine() : ConcreteEngine(new Schema) {}
+
+ConcreteEngine::ConcreteEngine(Schema* schema) : Engine(schema) {
   LOG(INFO) << "starting engine.";
   // receive context notifications
   context_->commit_notifier().connect([this](Context* ctx) { OnCommit(ctx); });
   context_->select_notifier().connect([this](Context* ctx) { OnSelect(ctx); });
   context_->update_notifier().connect(
       [this](Context* ctx) { OnContextUpdate(ctx); });
+  // memories update user dictionaries next, which the menu may be reading.
+  context_->delete_notifier().connect([this](Context* ctx) {
+    StopPrefetch();
+    WaitForUserDictQueries();
+  });
   context_->option_update_notifier().connect(
       [this](Context* ctx, const string& option) {
         OnOptionUpdate(ctx, option);
@@ -93,18 +151,28 @@ ConcreteEngine::ConcreteEngine() {
 }
 
 ConcreteEngine::~ConcreteEngine() {
+  // menus outlive the engine in context_, but not its translators and filters
+  StopPrefetch();
+  // waits for queries still running on worker threads
+  pending_.clear();
   LOG(INFO) << "engine disposed.";
 }
 
 bool ConcreteEngine::ProcessKey(const KeyEvent& key_event) {
   DLOG(INFO) << "process key: " << key_event;
+  PrefetchPause pause(this);
+  TraceScope trace(tracer_.get(), "process_key");
   ProcessResult ret = kNoop;
   for (auto& processor : processors_) {
     ret = processor->ProcessKeyEvent(key_event);
     if (ret == kRejected)
       break;
-    if (ret == kAccepted)
+    if (ret == kAccepted) {
+      // processors may have edited the composition in place.
+      context_->MarkChanged();
+      MergeLateTranslations();
       return true;
+    }
   }
   // record unhandled keys, eg. spaces, numbers, bksp's.
   context_->commit_history().Push(key_event);
@@ -113,11 +181,16 @@ bool ConcreteEngine::ProcessKey(const KeyEvent& key_event) {
     ret = processor->ProcessKeyEvent(key_event);
     if (ret == kRejected)
       break;
-    if (ret == kAccepted)
+    if (ret == kAccepted) {
+      context_->MarkChanged();
+      MergeLateTranslations();
       return true;
+    }
   }
-  // notify interested parties
+  // notify interested parties; memories may write to user dictionaries.
+  WaitForUserDictQueries();
   context_->unhandled_key_notifier()(context_.get(), key_event);
+  MergeLateTranslations();
   return false;
 }
 
@@ -154,6 +227,8 @@ void ConcreteEngine::OnPropertyUpdate(Context* ctx, const string& property) {
 void ConcreteEngine::Compose(Context* ctx) {
   if (!ctx)
     return;
+  PrefetchPause pause(this);
+  TraceScope trace(tracer_.get(), "compose");
   Composition& comp = ctx->composition();
   const string active_input = ctx->input().substr(0, ctx->caret_pos());
   DLOG(INFO) << "active input: " << active_input;
@@ -165,10 +240,12 @@ void ConcreteEngine::Compose(Context* ctx) {
   }
   CalculateSegmentation(&comp);
   TranslateSegments(&comp);
+  MergeLateTranslations();
   DLOG(INFO) << "composition: [" << comp.GetDebugText() << "]";
 }
 
 void ConcreteEngine::CalculateSegmentation(Segmentation* segments) {
+  TraceScope trace(tracer_.get(), "segmentation");
   DLOG(INFO) << "CalculateSegmentation, segments: " << segments->size()
              << ", finished? " << segments->HasFinishedSegmentation();
   while (!segments->HasFinishedSegmentation()) {
@@ -202,6 +279,15 @@ void ConcreteEngine::CalculateSegmentation(Segmentation* segments) {
 
 void ConcreteEngine::TranslateSegments(Segmentation* segments) {
   DLOG(INFO) << "TranslateSegments: " << *segments;
+  TraceScope trace(tracer_.get(), "translate");
+  bool tracing = tracer_->enabled();
+  // translations and filters are drained lazily; with menu/prefetch_pages,
+  // the first page and that many more are prepared on a worker thread while
+  // the engine is idle, so that paging need not wait.
+  prefetch_count_ = 0;
+  if (schema_->prefetch_pages() > 0 && !tracing) {
+    prefetch_count_ = schema_->page_size() * (1 + schema_->prefetch_pages());
+  }
   for (Segment& segment : *segments) {
     DLOG(INFO) << "segment [" << segment.start << ", " << segment.end
                << "), status: " << segment.status;
@@ -211,14 +297,72 @@ void ConcreteEngine::TranslateSegments(Segmentation* segments) {
     string input = segments->input().substr(segment.start, len);
     DLOG(INFO) << "translating segment: [" << input << "]";
     auto menu = New<Menu>();
-    for (auto& translator : translators_) {
-      auto translation = translator->Query(input, segment);
+    if (tracing) {
+      menu->set_tracer(tracer_);
+    }
+    auto deadline = std::chrono::steady_clock::now() + latency_budget_;
+    // start concurrent queries first so that they overlap the others.
+    for (size_t i = 0; i < translators_.size(); ++i) {
+      if (!concurrent_[i])
+        continue;
+      PendingQuery& pending = pending_[i];
+      if (pending.result.valid()) {
+        // a translator is never queried on two threads at once.
+        if (pending.result.wait_until(deadline) != std::future_status::ready) {
+          DLOG(INFO) << translators_[i]->name_space() << " is still busy.";
+          continue;
+        }
+        if (pending.input == input && pending.start == segment.start)
+          continue;
+        // made for a segment that has been translated anew
+        pending.result.get();
+      }
+      pending.menu.reset();
+      // reads the engine here, before the rest runs on a worker thread.
+      auto query = translators_[i]->PrepareQuery(input, segment);
+      if (!query)
+        continue;
+      pending.result = std::async(std::launch::async, std::move(query));
+      pending.input = input;
+      pending.start = segment.start;
+    }
+    vector<an<Translation>> translations(translators_.size());
+    for (size_t i = 0; i < translators_.size(); ++i) {
+      auto& translator = translators_[i];
+      if (concurrent_[i]) {
+        PendingQuery& pending = pending_[i];
+        if (!pending.result.valid() || pending.input != input ||
+            pending.start != segment.start)
+          continue;
+        if (pending.result.wait_until(deadline) != std::future_status::ready) {
+          DLOG(INFO) << translator->name_space() << " missed the deadline.";
+          pending.menu = menu;
+          continue;
+        }
+        pending.menu.reset();
+        translations[i] = pending.result.get();
+      } else if (tracing) {
+        TraceScope trace_query(tracer_.get(),
+                               "translator/" + translator->name_space());
+        translations[i] = translator->Query(input, segment);
+      } else {
+        translations[i] = translator->Query(input, segment);
+      }
+    }
+    for (size_t i = 0; i < translators_.size(); ++i) {
+      auto& translation = translations[i];
       if (!translation)
         continue;
       if (translation->exhausted()) {
-        DLOG(INFO) << translator->name_space() << " made a futile translation.";
+        DLOG(INFO) << translators_[i]->name_space()
+                   << " made a futile translation.";
         continue;
       }
+      if (tracing) {
+        translation = New<TracedTranslation>(
+            translation, tracer_,
+            "translator/" + translators_[i]->name_space() + "/candidates");
+      }
       menu->AddTranslation(translation);
     }
     for (auto& filter : filters_) {
@@ -226,12 +370,66 @@ void ConcreteEngine::TranslateSegments(Segmentation* segments) {
         menu->AddFilter(filter.get());
       }
     }
+    if (prefetch_count_) {
+      // started when the engine goes idle
+      prefetching_ = menu;
+    }
     segment.status = Segment::kGuess;
     segment.menu = menu;
     segment.selected_index = 0;
   }
 }
 
+void ConcreteEngine::PausePrefetch() {
+  if (prefetch_paused_++ > 0)
+    return;
+  if (auto menu = prefetching_.lock())
+    menu->CancelPrefetch();
+}
+
+void ConcreteEngine::ResumePrefetch() {
+  if (--prefetch_paused_ > 0 || prefetch_count_ == 0)
+    return;
+  if (auto menu = prefetching_.lock())
+    menu->Prefetch(prefetch_count_);
+}
+
+void ConcreteEngine::StopPrefetch() {
+  if (auto menu = prefetching_.lock())
+    menu->CancelPrefetch();
+  prefetching_.reset();
+}
+
+void ConcreteEngine::MergeLateTranslations() {
+  for (size_t i = 0; i < pending_.size(); ++i) {
+    PendingQuery& pending = pending_[i];
+    auto menu = pending.menu.lock();
+    if (!menu || pending.result.wait_for(std::chrono::seconds(0)) !=
+                     std::future_status::ready)
+      continue;
+    pending.menu.reset();
+    auto translation = pending.result.get();
+    if (!translation || translation->exhausted())
+      continue;
+    DLOG(INFO) << translators_[i]->name_space() << " is merged late.";
+    if (tracer_->enabled()) {
+      translation = New<TracedTranslation>(
+          translation, tracer_,
+          "translator/" + translators_[i]->name_space() + "/candidates");
+    }
+    // candidates obtained so far stay in place; the rest are merged.
+    menu->AddTranslation(translation);
+  }
+}
+
+void ConcreteEngine::WaitForUserDictQueries() {
+  for (size_t i = 0; i < pending_.size(); ++i) {
+    if (pending_[i].result.valid() &&
+        !translators_[i]->user_dict_name().empty())
+      pending_[i].result.wait();
+  }
+}
+
 void ConcreteEngine::FormatText(string* text) {
   if (formatters_.empty())
     return;
@@ -249,6 +447,10 @@ void ConcreteEngine::CommitText(string text) {
 }
 
 void ConcreteEngine::OnCommit(Context* ctx) {
+  // memories learn from the commit next; the menu is done with, and so are
+  // queries still running, which may read the same user dictionaries.
+  StopPrefetch();
+  WaitForUserDictQueries();
   context_->commit_history().Push(ctx->composition(), ctx->input());
   string text = ctx->GetCommitText();
   FormatText(&text);
@@ -326,6 +528,9 @@ inline void CreateComponentsFromList(Engine* engine,
 }
 
 void ConcreteEngine::InitializeComponents() {
+  StopPrefetch();
+  pending_.clear();
+  concurrent_.clear();
   processors_.clear();
   segmentors_.clear();
   translators_.clear();
@@ -355,6 +560,47 @@ void ConcreteEngine::InitializeComponents() {
                                        "translator", translators_);
   CreateComponentsFromList<Filter>(this, config, "engine/filters", "filter",
                                    filters_);
+  // translators listed by name space are queried on worker threads, and
+  // only waited for until the latency budget runs out. it takes a thread-safe
+  // translator that shares no user dictionary with the others.
+  concurrent_.assign(translators_.size(), false);
+  pending_.resize(translators_.size());
+  latency_budget_ = std::chrono::milliseconds(kDefaultLatencyBudget);
+  if (auto concurrent_list = config->GetList("engine/concurrent_translators")) {
+    for (size_t j = 0; j < concurrent_list->size(); ++j) {
+      auto name_space = concurrent_list->GetValueAt(j);
+      if (!name_space)
+        continue;
+      for (size_t i = 0; i < translators_.size(); ++i) {
+        auto& translator = translators_[i];
+        if (translator->name_space() != name_space->str())
+          continue;
+        if (!translator->thread_safe()) {
+          LOG(WARNING) << "translator is not thread-safe: "
+                       << translator->name_space();
+          continue;
+        }
+        string user_dict = translator->user_dict_name();
+        bool shared = !user_dict.empty() &&
+                      std::any_of(translators_.begin(), translators_.end(),
+                                  [&](const of<Translator>& other) {
+                                    return other != translator &&
+                                           other->user_dict_name() == user_dict;
+                                  });
+        if (shared) {
+          LOG(WARNING) << "translator shares user dictionary '" << user_dict
+                       << "': " << translator->name_space();
+          continue;
+        }
+        concurrent_[i] = true;
+      }
+    }
+    int latency_budget = 0;
+    if (config->GetInt("engine/translation_latency_budget", &latency_budget) &&
+        latency_budget >= 0) {
+      latency_budget_ = std::chrono::milliseconds(latency_budget);
+    }
+  }
   // create formatters
   auto c_formatter = Formatter::Require("shape_formatter");
   if (c_formatter) {
@@ -16,6 +16,7 @@ namespace rime {
 class KeyEvent;
 class Schema;
 class Context;
+class Tracer;
 
 class Engine : public Messenger {
  public:
@@ -30,18 +31,23 @@ class Engine : public Messenger {
   Schema* schema() const { return schema_.get(); }
   Context* context() const { return context_.get(); }
   CommitSink& sink() { return sink_; }
+  an<Tracer> tracer() const { return tracer_; }
 
   Engine* active_engine() { return active_engine_ ? active_engine_ : this; }
   void set_active_engine(Engine* engine = nullptr) { active_engine_ = engine; }
 
   RIME_DLL static Engine* Create();
+  // starts with the given schema rather than the one chosen by the switcher.
+  RIME_DLL static Engine* Create(Schema* schema);
 
  protected:
   Engine();
+  explicit Engine(Schema* schema);
 
   the<Schema> schema_;
   the<Context> context_;
   CommitSink sink_;
+  an<Tracer> tracer_;
   Engine* active_engine_ = nullptr;
 };
 
@@ -24,7 +24,7 @@ TagMatching::TagMatching(const Ticket& ticket) {
   }
 }
 
-bool TagMatching::TagsMatch(Segment* segment) {
+bool TagMatching::TagsMatch(const Segment* segment) const {
   if (!segment)
     return false;
   if (tags_.empty())  // match any
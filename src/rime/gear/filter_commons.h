@@ -15,7 +15,7 @@ struct Ticket;
 class TagMatching {
  public:
   explicit TagMatching(const Ticket& ticket);
-  bool TagsMatch(Segment* segment);
+  bool TagsMatch(const Segment* segment) const;
 
  protected:
   vector<string> tags_;
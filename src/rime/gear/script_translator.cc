@@ -206,6 +206,13 @@ ScriptTranslator::ScriptTranslator(const Ticket& ticket)
 
 an<Translation> ScriptTranslator::Query(const string& input,
                                         const Segment& segment) {
+  auto query = PrepareQuery(input, segment);
+  return query ? query() : nullptr;
+}
+
+function<an<Translation>()> ScriptTranslator::PrepareQuery(
+    const string& input,
+    const Segment& segment) {
   if (!dict_ || !dict_->loaded())
     return nullptr;
   if (!segment.HasAnyTagIn(tags_))
@@ -218,10 +225,20 @@ an<Translation> ScriptTranslator::Query(const string& input,
   bool enable_user_dict =
       user_dict_ && user_dict_->loaded() && !IsUserDictDisabledFor(input);
 
+  size_t start = segment.start;
   size_t end_of_input = engine_->context()->input().length();
+  return [this, input, start, end_of_input, enable_user_dict] {
+    return Translate(input, start, end_of_input, enable_user_dict);
+  };
+}
+
+an<Translation> ScriptTranslator::Translate(const string& input,
+                                            size_t start,
+                                            size_t end_of_input,
+                                            bool enable_user_dict) {
   // the translator should survive translations it creates
   auto result = New<ScriptTranslation>(
-      this, corrector_.get(), poet_.get(), input, segment.start, end_of_input,
+      this, corrector_.get(), poet_.get(), input, start, end_of_input,
       max_sentences_, sentence_cutoff_threshold_);
   if (!result || !result->Evaluate(
                      dict_.get(), enable_user_dict ? user_dict_.get() : NULL)) {
@@ -229,7 +246,7 @@ an<Translation> ScriptTranslator::Query(const string& input,
   }
   auto deduped = New<DistinctTranslation>(result);
   if (contextual_suggestions_) {
-    return poet_->ContextualWeighted(deduped, input, segment.start, this);
+    return poet_->ContextualWeighted(deduped, input, start, this);
   }
   return deduped;
 }
@@ -315,6 +332,15 @@ string ScriptTranslator::Spell(const Code& code) {
   return result;
 }
 
+bool ScriptTranslator::thread_safe() const {
+  // contextual suggestions read the composition
+  return !contextual_suggestions_;
+}
+
+string ScriptTranslator::user_dict_name() const {
+  return user_dict_ ? user_dict_->name() : string();
+}
+
 string ScriptTranslator::GetPrecedingText(size_t start) const {
   return !contextual_suggestions_ ? string()
          : start > 0 ? engine_->context()->composition().GetTextBefore(start)
@@ -701,12 +727,16 @@ WordGraph ScriptTranslation::PrepareForMakingSentence(
   const int kMaxSyllablesForUserPhraseQuery = 5;
   const auto& syllable_graph = syllabifier_->syllable_graph();
   WordGraph graph;
+  UserDictEntryCollectors user_phrases;
+  if (user_dict) {
+    user_phrases =
+        user_dict->LookupAll(syllable_graph, kMaxSyllablesForUserPhraseQuery);
+  }
   for (const auto& x : syllable_graph.edges) {
     auto& same_start_pos = graph[x.first];
-    if (user_dict) {
-      EnrollEntries(same_start_pos,
-                    user_dict->Lookup(syllable_graph, x.first,
-                                      kMaxSyllablesForUserPhraseQuery));
+    auto user_phrase = user_phrases.find(x.first);
+    if (user_phrase != user_phrases.end()) {
+      EnrollEntries(same_start_pos, user_phrase->second);
     }
     // merge lookup results
     EnrollEntries(same_start_pos, dict->Lookup(syllable_graph, x.first,
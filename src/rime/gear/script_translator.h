@@ -32,9 +32,14 @@ class ScriptTranslator : public Translator,
 
   virtual an<Translation> Query(const string& input,
                                 const Segment& segment) override;
+  virtual function<an<Translation>()> PrepareQuery(
+      const string& input,
+      const Segment& segment) override;
   virtual bool Memorize(const CommitEntry& commit_entry) override;
   virtual bool ProcessSegmentOnCommit(CommitEntry& commit_entry,
                                       const Segment& seg) override;
+  virtual bool thread_safe() const override;
+  virtual string user_dict_name() const override;
 
   string FormatPreedit(const string& preedit);
   string Spell(const Code& code);
@@ -54,6 +59,12 @@ class ScriptTranslator : public Translator,
   int core_word_length() const;
 
  protected:
+  // the part of a query that reads nothing of the engine
+  an<Translation> Translate(const string& input,
+                            size_t start,
+                            size_t end_of_input,
+                            bool enable_user_dict);
+
   int max_homophones_ = 1;
   int spelling_hints_ = 0;
   int max_word_length_ = 0;
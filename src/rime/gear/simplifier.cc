@@ -7,6 +7,7 @@
 #include <boost/algorithm/string.hpp>
 #include <stdint.h>
 #include <utf8.h>
+#include <mutex>
 #include <utility>
 #include <rime/candidate.h>
 #include <rime/common.h>
@@ -29,15 +30,12 @@ static const char* quote_right = "\xe3\x80\x95";  //"\xef\xbc\x89";
 
 namespace rime {
 
-class Opencc {
- public:
-  Opencc(const path& config_path)
-      : initialized_(false), config_path_(config_path) {}
+// Opencc
+
+Opencc::Opencc(const path& config_path) : config_path_(config_path) {}
 
-  void Initialize() {
-    if (initialized_)
-      return;
-    initialized_ = true;
+void Opencc::Initialize() {
+  std::call_once(initialized_, [this] {
     opencc::Config config;
     try {
       // opencc accepts file path encoded in UTF-8.
@@ -49,121 +47,170 @@ class Opencc {
     } catch (...) {
       LOG(ERROR) << "opencc config not found: " << config_path_;
     }
+  });
+}
+
+bool Opencc::ConvertWord(const string& text, vector<string>* forms) {
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto found = word_cache_.find(text);
+    if (found != word_cache_.end()) {
+      if (found->second.empty())
+        return false;
+      *forms = found->second;
+      return true;
+    }
+  }
+  vector<string> converted;
+  bool success = DoConvertWord(text, &converted);
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (word_cache_.size() >= kMaxCachedConversions) {
+    word_cache_.clear();
+  }
+  // an empty list of forms stands for a failed conversion
+  word_cache_[text] = success ? converted : vector<string>();
+  if (success) {
+    *forms = std::move(converted);
+  }
+  return success;
+}
+
+bool Opencc::ConvertText(const string& text, string* simplified) {
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto found = text_cache_.find(text);
+    if (found != text_cache_.end()) {
+      *simplified = found->second;
+      return *simplified != text;
+    }
+  }
+  string converted;
+  if (!DoConvertText(text, &converted))
+    converted = text;
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (text_cache_.size() >= kMaxCachedConversions) {
+    text_cache_.clear();
   }
+  text_cache_[text] = converted;
+  *simplified = std::move(converted);
+  return *simplified != text;
+}
 
-  bool ConvertWord(const string& text, vector<string>* forms) {
-    Initialize();
-    if (converter_ == nullptr) {
+bool Opencc::RandomConvertText(const string& text, string* simplified) {
+  Initialize();
+  if (dict_ == nullptr)
+    return false;
+  const list<opencc::ConversionPtr> conversions =
+      converter_->GetConversionChain()->GetConversions();
+  const char* phrase = text.c_str();
+  for (auto conversion : conversions) {
+    opencc::DictPtr dict = conversion->GetDict();
+    if (dict == nullptr) {
       return false;
     }
-    const list<opencc::ConversionPtr> conversions =
-        converter_->GetConversionChain()->GetConversions();
-    vector<string> original_words{text};
-    bool matched = false;
-    for (auto conversion : conversions) {
-      opencc::DictPtr dict = conversion->GetDict();
-      if (dict == nullptr) {
-        return false;
-      }
-      set<string> word_set;
-      vector<string> converted_words;
-      for (const auto& original_word : original_words) {
-        opencc::Optional<const opencc::DictEntry*> item =
-            dict->Match(original_word);
-        if (item.IsNull()) {
-          // There is no exact match, but still need to convert partially
-          // matched in a chain conversion. Here apply default (max. seg.)
-          // match to get the most probable conversion result
-          std::ostringstream buffer;
-          for (const char* wstr = original_word.c_str(); *wstr != '\0';) {
-            opencc::Optional<const opencc::DictEntry*> matched =
-                dict->MatchPrefix(wstr);
-            size_t matched_length;
-            if (matched.IsNull()) {
-              matched_length = opencc::UTF8Util::NextCharLength(wstr);
-              buffer << opencc::UTF8Util::FromSubstr(wstr, matched_length);
-            } else {
-              matched_length = matched.Get()->KeyLength();
-              buffer << matched.Get()->GetDefault();
-            }
-            wstr += matched_length;
-          }
-          const string& converted_word = buffer.str();
-          // Even if current dictionary doesn't convert the word
-          // (converted_word == original_word), we still need to keep it for
-          // subsequent dicts in the chain. e.g. s2t.json expands 里 to 里 and
-          // 裏, then t2tw.json passes 里 as-is and converts 裏 to 裡.
-          if (word_set.insert(converted_word).second) {
-            converted_words.push_back(converted_word);
-          }
-          continue;
-        }
-        matched = true;
-        const opencc::DictEntry* entry = item.Get();
-        for (const auto& converted_word : entry->Values()) {
-          if (word_set.insert(converted_word).second) {
-            converted_words.push_back(converted_word);
-          }
-        }
+    std::ostringstream buffer;
+    for (const char* pstr = phrase; *pstr != '\0';) {
+      opencc::Optional<const opencc::DictEntry*> matched =
+          dict->MatchPrefix(pstr);
+      size_t matched_length;
+      if (matched.IsNull()) {
+        matched_length = opencc::UTF8Util::NextCharLength(pstr);
+        buffer << opencc::UTF8Util::FromSubstr(pstr, matched_length);
+      } else {
+        matched_length = matched.Get()->KeyLength();
+        size_t i = rand() % (matched.Get()->NumValues());
+        buffer << matched.Get()->Values().at(i);
       }
-      original_words.swap(converted_words);
-    }
-    if (!matched) {
-      // No dictionary contains the word
-      return false;
+      pstr += matched_length;
     }
-    *forms = std::move(original_words);
-    return forms->size() > 0;
+    *simplified = buffer.str();
+    phrase = simplified->c_str();
   }
+  return *simplified != text;
+}
 
-  bool RandomConvertText(const string& text, string* simplified) {
-    Initialize();
-    if (dict_ == nullptr)
+bool Opencc::DoConvertWord(const string& text, vector<string>* forms) {
+  Initialize();
+  if (converter_ == nullptr) {
+    return false;
+  }
+  const list<opencc::ConversionPtr> conversions =
+      converter_->GetConversionChain()->GetConversions();
+  vector<string> original_words{text};
+  bool matched = false;
+  for (auto conversion : conversions) {
+    opencc::DictPtr dict = conversion->GetDict();
+    if (dict == nullptr) {
       return false;
-    const list<opencc::ConversionPtr> conversions =
-        converter_->GetConversionChain()->GetConversions();
-    const char* phrase = text.c_str();
-    for (auto conversion : conversions) {
-      opencc::DictPtr dict = conversion->GetDict();
-      if (dict == nullptr) {
-        return false;
+    }
+    set<string> word_set;
+    vector<string> converted_words;
+    for (const auto& original_word : original_words) {
+      opencc::Optional<const opencc::DictEntry*> item =
+          dict->Match(original_word);
+      if (item.IsNull()) {
+        // There is no exact match, but still need to convert partially
+        // matched in a chain conversion. Here apply default (max. seg.)
+        // match to get the most probable conversion result
+        std::ostringstream buffer;
+        for (const char* wstr = original_word.c_str(); *wstr != '\0';) {
+          opencc::Optional<const opencc::DictEntry*> matched =
+              dict->MatchPrefix(wstr);
+          size_t matched_length;
+          if (matched.IsNull()) {
+            matched_length = opencc::UTF8Util::NextCharLength(wstr);
+            buffer << opencc::UTF8Util::FromSubstr(wstr, matched_length);
+          } else {
+            matched_length = matched.Get()->KeyLength();
+            buffer << matched.Get()->GetDefault();
+          }
+          wstr += matched_length;
+        }
+        const string& converted_word = buffer.str();
+        // Even if current dictionary doesn't convert the word
+        // (converted_word == original_word), we still need to keep it for
+        // subsequent dicts in the chain. e.g. s2t.json expands 里 to 里 and
+        // 裏, then t2tw.json passes 里 as-is and converts 裏 to 裡.
+        if (word_set.insert(converted_word).second) {
+          converted_words.push_back(converted_word);
+        }
+        continue;
       }
-      std::ostringstream buffer;
-      for (const char* pstr = phrase; *pstr != '\0';) {
-        opencc::Optional<const opencc::DictEntry*> matched =
-            dict->MatchPrefix(pstr);
-        size_t matched_length;
-        if (matched.IsNull()) {
-          matched_length = opencc::UTF8Util::NextCharLength(pstr);
-          buffer << opencc::UTF8Util::FromSubstr(pstr, matched_length);
-        } else {
-          matched_length = matched.Get()->KeyLength();
-          size_t i = rand() % (matched.Get()->NumValues());
-          buffer << matched.Get()->Values().at(i);
+      matched = true;
+      const opencc::DictEntry* entry = item.Get();
+      for (const auto& converted_word : entry->Values()) {
+        if (word_set.insert(converted_word).second) {
+          converted_words.push_back(converted_word);
         }
-        pstr += matched_length;
       }
-      *simplified = buffer.str();
-      phrase = simplified->c_str();
     }
-    return *simplified != text;
+    original_words.swap(converted_words);
   }
-
-  bool ConvertText(const string& text, string* simplified) {
-    Initialize();
-    if (converter_ == nullptr)
-      return false;
-    *simplified = converter_->Convert(text);
-    return *simplified != text;
+  if (!matched) {
+    // No dictionary contains the word
+    return false;
   }
+  *forms = std::move(original_words);
+  return forms->size() > 0;
+}
 
- private:
-  bool initialized_;
-  path config_path_;
-  opencc::ConverterPtr converter_;
-  opencc::DictPtr dict_;
-};
+bool Opencc::DoConvertText(const string& text, string* simplified) {
+  Initialize();
+  if (converter_ == nullptr)
+    return false;
+  *simplified = converter_->Convert(text);
+  return true;
+}
 
+size_t Opencc::cached_words() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return word_cache_.size();
+}
+
+size_t Opencc::cached_texts() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return text_cache_.size();
+}
 // Simplifier
 
 Simplifier::Simplifier(const Ticket& ticket, an<Opencc> opencc)
@@ -7,13 +7,50 @@
 #ifndef RIME_SIMPLIFIER_H_
 #define RIME_SIMPLIFIER_H_
 
+#include <mutex>
 #include <rime/filter.h>
 #include <rime/algo/algebra.h>
 #include <rime/gear/filter_commons.h>
 
+namespace opencc {
+
+class Converter;
+class Dict;
+
+}  // namespace opencc
+
 namespace rime {
 
-class Opencc;
+// an instance is shared by all simplifiers using the same opencc config.
+class Opencc {
+ public:
+  // conversions of frequent words are cached; the cache is emptied once it
+  // grows to this many entries.
+  static const size_t kMaxCachedConversions = 8192;
+
+  explicit Opencc(const path& config_path);
+
+  void Initialize();
+  bool ConvertWord(const string& text, vector<string>* forms);
+  bool ConvertText(const string& text, string* simplified);
+  bool RandomConvertText(const string& text, string* simplified);
+
+  // the number of words and texts whose conversions are cached.
+  size_t cached_words() const;
+  size_t cached_texts() const;
+
+ private:
+  bool DoConvertWord(const string& text, vector<string>* forms);
+  bool DoConvertText(const string& text, string* simplified);
+
+  std::once_flag initialized_;
+  path config_path_;
+  an<opencc::Converter> converter_;
+  an<opencc::Dict> dict_;
+  mutable std::mutex cache_mutex_;
+  hash_map<string, vector<string>> word_cache_;
+  hash_map<string, string> text_cache_;
+};
 
 class Simplifier : public Filter, TagMatching {
  public:
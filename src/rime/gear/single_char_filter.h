@@ -8,15 +8,18 @@
 #define RIME_SINGLE_CHAR_FILTER_H_
 
 #include <rime/filter.h>
+#include <rime/gear/filter_commons.h>
 
 namespace rime {
 
-class SingleCharFilter : public Filter {
+class SingleCharFilter : public Filter, TagMatching {
  public:
   explicit SingleCharFilter(const Ticket& ticket);
 
   virtual an<Translation> Apply(an<Translation> translation,
                                 CandidateList* candidates);
+
+  virtual bool AppliesToSegment(Segment* segment) { return TagsMatch(segment); }
 };
 
 }  // namespace rime
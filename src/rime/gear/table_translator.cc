@@ -6,6 +6,7 @@
 //
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <cmath>
 #include <utf8.h>
 #include <rime/candidate.h>
@@ -54,16 +55,34 @@ TableTranslation::TableTranslation(TranslatorOptions* options,
 bool TableTranslation::Next() {
   if (exhausted())
     return false;
-  if (PreferUserPhrase()) {
-    uter_.Next();
-    if (uter_.exhausted())
-      FetchMoreUserPhrases();
-  } else {
-    iter_.Next();
-    if (iter_.exhausted())
-      FetchMoreTableEntries();
-  }
-  return !CheckEmpty();
+  do {
+    if (PreferUserPhrase()) {
+      uter_.Next();
+      if (uter_.exhausted())
+        FetchMoreUserPhrases();
+    } else {
+      iter_.Next();
+      if (iter_.exhausted())
+        FetchMoreTableEntries();
+    }
+  } while (!CheckEmpty() && IsExcluded(*PreferredEntry(PreferUserPhrase())));
+  return !exhausted();
+}
+
+void TableTranslation::ExcludeSingleChars() {
+  exclude_single_chars_ = true;
+  if (!exhausted() && IsExcluded(*PreferredEntry(PreferUserPhrase())))
+    Next();
+}
+
+static bool is_single_char(const string& text) {
+  const char* text_end = text.c_str() + text.length();
+  return utf8::unchecked::distance(text.c_str(), text_end) == 1;
+}
+
+bool TableTranslation::IsExcluded(const DictEntry& entry) const {
+  return exclude_single_chars_ && entry.remaining_code_length == 0 &&
+         is_single_char(entry.text);
 }
 
 static bool is_constructed(const DictEntry* e) {
@@ -223,6 +242,25 @@ TableTranslator::TableTranslator(const Ticket& ticket)
                     &encode_commit_history_);
     config->GetInt(name_space_ + "/max_phrase_length", &max_phrase_length_);
     config->GetInt(name_space_ + "/max_homographs", &max_homographs_);
+    // unless configured, single_char_filter in the schema turns it on for
+    // the segments the filter applies to.
+    bool single_char_first = false;
+    if (config->GetBool(name_space_ + "/single_char_first",
+                        &single_char_first)) {
+      if (single_char_first)
+        single_char_first_.reset(new TagMatching(Ticket()));
+    } else if (auto filters = config->GetList("engine/filters")) {
+      for (size_t i = 0; i < filters->size(); ++i) {
+        auto prescription = filters->GetValueAt(i);
+        if (!prescription)
+          continue;
+        Ticket filter_ticket(engine_, "filter", prescription->str());
+        if (filter_ticket.klass == "single_char_filter") {
+          single_char_first_.reset(new TagMatching(filter_ticket));
+          break;
+        }
+      }
+    }
     if (enable_sentence_ || sentence_over_completion_ ||
         contextual_suggestions_) {
       poet_.reset(new Poet(language(), config, Poet::LeftAssociateCompare));
@@ -243,6 +281,13 @@ static bool starts_with_completion(an<Translation> translation) {
 
 an<Translation> TableTranslator::Query(const string& input,
                                        const Segment& segment) {
+  auto query = PrepareQuery(input, segment);
+  return query ? query() : nullptr;
+}
+
+function<an<Translation>()> TableTranslator::PrepareQuery(
+    const string& input,
+    const Segment& segment) {
   if (!segment.HasAnyTagIn(tags_))
     return nullptr;
   DLOG(INFO) << "input = '" << input << "', [" << segment.start << ", "
@@ -252,49 +297,58 @@ an<Translation> TableTranslator::Query(const string& input,
 
   bool enable_user_dict =
       user_dict_ && user_dict_->loaded() && !IsUserDictDisabledFor(input);
+  bool filter_by_charset = enable_charset_filter_ &&
+                           !engine_->context()->get_option("extended_charset");
+  // rather than having single_char_filter drain all exact matches to reorder
+  // them, look up single characters and the rest apart.
+  bool single_char_first =
+      single_char_first_ && single_char_first_->TagsMatch(&segment);
+  size_t start = segment.start;
+  return [this, input, start, enable_user_dict, filter_by_charset,
+          single_char_first] {
+    return Translate(input, start, enable_user_dict, filter_by_charset,
+                     single_char_first);
+  };
+}
 
+an<Translation> TableTranslator::Translate(const string& input,
+                                           size_t start,
+                                           bool enable_user_dict,
+                                           bool filter_by_charset,
+                                           bool single_char_first) {
   const string& preedit(input);
   string code = input;
   boost::trim_right_if(code, boost::is_any_of(delimiters_));
 
+  size_t end = start + input.length();
   an<Translation> translation;
   if (enable_completion_) {
-    translation = Cached<LazyTableTranslation>(this, code, segment.start,
-                                               segment.start + input.length(),
-                                               preedit, enable_user_dict);
+    auto lazy = New<LazyTableTranslation>(this, code, start, end, preedit,
+                                          enable_user_dict);
+    if (single_char_first)
+      lazy->ExcludeSingleChars();
+    translation = New<CacheTranslation>(lazy);
   } else {
-    DictEntryIterator iter;
-    if (dict_ && dict_->loaded()) {
-      dict_->LookupWords(&iter, code, false, 0, &blacklist());
-    }
-    UserDictEntryIterator uter;
-    if (enable_user_dict) {
-      user_dict_->LookupWords(&uter, code, false);
-      if (encoder_ && encoder_->loaded()) {
-        encoder_->LookupPhrases(&uter, code, false);
-      }
-    }
-    if (!iter.exhausted() || !uter.exhausted())
-      translation = Cached<TableTranslation>(
-          this, language(), code, segment.start, segment.start + input.length(),
-          preedit, std::move(iter), std::move(uter));
-  }
-  if (translation) {
-    bool filter_by_charset =
-        enable_charset_filter_ &&
-        !engine_->context()->get_option("extended_charset");
-    if (filter_by_charset) {
-      translation = New<CharsetFilterTranslation>(translation);
-    }
+    translation =
+        LookupExactMatches(code, start, end, preedit, enable_user_dict,
+                           single_char_first ? kMultiChar : kAnyLength);
+  }
+  if (single_char_first) {
+    translation = LookupExactMatches(code, start, end, preedit,
+                                     enable_user_dict, kSingleChar) +
+                  translation;
+  }
+  if (translation && filter_by_charset) {
+    translation = New<CharsetFilterTranslation>(translation);
   }
   if (translation && translation->exhausted()) {
     translation.reset();  // discard futile translation
   }
   if (enable_sentence_ && !translation) {
-    translation = MakeSentence(input, segment.start,
+    translation = MakeSentence(input, start, filter_by_charset,
                                /* include_prefix_phrases = */ true);
   } else if (sentence_over_completion_ && starts_with_completion(translation)) {
-    if (auto sentence = MakeSentence(input, segment.start)) {
+    if (auto sentence = MakeSentence(input, start, filter_by_charset)) {
       translation = sentence + translation;
     }
   }
@@ -303,11 +357,40 @@ an<Translation> TableTranslator::Query(const string& input,
   }
   translation = New<DistinctTranslation>(translation);
   if (contextual_suggestions_) {
-    return poet_->ContextualWeighted(translation, input, segment.start, this);
+    return poet_->ContextualWeighted(translation, input, start, this);
   }
   return translation;
 }
 
+an<Translation> TableTranslator::LookupExactMatches(const string& code,
+                                                    size_t start,
+                                                    size_t end,
+                                                    const string& preedit,
+                                                    bool enable_user_dict,
+                                                    LengthClass length_class) {
+  DictEntryIterator iter;
+  if (dict_ && dict_->loaded()) {
+    dict_->LookupWords(&iter, code, false, 0, &blacklist(), length_class);
+  }
+  UserDictEntryIterator uter;
+  if (enable_user_dict) {
+    user_dict_->LookupWords(&uter, code, false);
+    if (encoder_ && encoder_->loaded()) {
+      encoder_->LookupPhrases(&uter, code, false);
+    }
+    if (length_class != kAnyLength) {
+      bool single_char = length_class == kSingleChar;
+      uter.AddFilter([single_char](an<DictEntry> entry) {
+        return entry && is_single_char(entry->text) == single_char;
+      });
+    }
+  }
+  if (iter.exhausted() && uter.exhausted())
+    return nullptr;
+  return Cached<TableTranslation>(this, language(), code, start, end, preedit,
+                                  std::move(iter), std::move(uter));
+}
+
 bool TableTranslator::Memorize(const CommitEntry& commit_entry) {
   if (!user_dict_)
     return false;
@@ -355,6 +438,15 @@ bool TableTranslator::Memorize(const CommitEntry& commit_entry) {
   return true;
 }
 
+bool TableTranslator::thread_safe() const {
+  // contextual suggestions read the composition
+  return !contextual_suggestions_;
+}
+
+string TableTranslator::user_dict_name() const {
+  return user_dict_ ? user_dict_->name() : string();
+}
+
 string TableTranslator::GetPrecedingText(size_t start) const {
   return !contextual_suggestions_ ? string()
          : start > 0 ? engine_->context()->composition().GetTextBefore(start)
@@ -542,13 +634,16 @@ inline static void collect_entries(DictEntryList& entries,
 
 an<Translation> TableTranslator::MakeSentence(const string& input,
                                               size_t start,
+                                              bool filter_by_charset,
                                               bool include_prefix_phrases) {
-  bool filter_by_charset = enable_charset_filter_ &&
-                           !engine_->context()->get_option("extended_charset");
   DictEntryCollector collector;
   UserDictEntryCollector user_phrase_collector;
   WordGraph graph;
   hash_set<int> vertices = {0};
+  Prism::MatchTable prism_matches;
+  if (dict_ && dict_->loaded()) {
+    dict_->prism()->CommonPrefixSearchAll(input, &prism_matches);
+  }
   for (size_t start_pos = 0; start_pos < input.length(); ++start_pos) {
     // find next reachable vertex in word graph
     if (vertices.find(start_pos) == vertices.end())
@@ -633,8 +728,8 @@ an<Translation> TableTranslator::MakeSentence(const string& input,
       }
     }
     if (dict_ && dict_->loaded()) {
-      vector<Prism::Match> matches;
-      dict_->prism()->CommonPrefixSearch(input.substr(start_pos), &matches);
+      auto matches = boost::make_iterator_range(prism_matches.begin(start_pos),
+                                                prism_matches.end(start_pos));
       if (matches.empty())
         continue;
       for (const auto& m : boost::adaptors::reverse(matches)) {
@@ -14,6 +14,7 @@
 #include <rime/algo/algebra.h>
 #include <rime/dict/dictionary.h>
 #include <rime/dict/user_dictionary.h>
+#include <rime/gear/filter_commons.h>
 #include <rime/gear/memory.h>
 #include <rime/gear/translator_commons.h>
 
@@ -29,15 +30,33 @@ class TableTranslator : public Translator,
   TableTranslator(const Ticket& ticket);
 
   virtual an<Translation> Query(const string& input, const Segment& segment);
+  virtual function<an<Translation>()> PrepareQuery(const string& input,
+                                                   const Segment& segment);
   virtual bool Memorize(const CommitEntry& commit_entry);
+  virtual bool thread_safe() const;
+  virtual string user_dict_name() const;
 
   an<Translation> MakeSentence(const string& input,
                                size_t start,
+                               bool filter_by_charset,
                                bool include_prefix_phrases = false);
   string GetPrecedingText(size_t start) const;
   UnityTableEncoder* encoder() const { return encoder_.get(); }
 
  protected:
+  // the part of a query that reads nothing of the engine
+  an<Translation> Translate(const string& input,
+                            size_t start,
+                            bool enable_user_dict,
+                            bool filter_by_charset,
+                            bool single_char_first);
+  an<Translation> LookupExactMatches(const string& code,
+                                     size_t start,
+                                     size_t end,
+                                     const string& preedit,
+                                     bool enable_user_dict,
+                                     LengthClass length_class);
+
   bool enable_charset_filter_ = false;
   bool enable_encoder_ = false;
   bool enable_sentence_ = true;
@@ -47,6 +66,8 @@ class TableTranslator : public Translator,
   int max_homographs_ = 1;
   the<Poet> poet_;
   the<UnityTableEncoder> encoder_;
+  // segments where single characters are looked up ahead of the others
+  the<TagMatching> single_char_first_;
 };
 
 class TableTranslation : public Translation {
@@ -63,12 +84,17 @@ class TableTranslation : public Translation {
   virtual bool Next();
   virtual an<Candidate> Peek();
 
+  // skips exact matches of a single character, which have been taken
+  // by a preceding translation.
+  void ExcludeSingleChars();
+
  protected:
   virtual bool FetchMoreUserPhrases() { return false; }
   virtual bool FetchMoreTableEntries() { return false; }
 
   bool CheckEmpty();
   bool PreferUserPhrase();
+  bool IsExcluded(const DictEntry& entry) const;
 
   an<DictEntry> PreferredEntry(bool prefer_user_phrase) {
     return prefer_user_phrase ? uter_.Peek() : iter_.Peek();
@@ -82,6 +108,7 @@ class TableTranslation : public Translation {
   string preedit_;
   DictEntryIterator iter_;
   UserDictEntryIterator uter_;
+  bool exclude_single_chars_ = false;
 };
 
 }  // namespace rime
@@ -4,6 +4,7 @@
 //
 // 2012-03-23 GONG Chen <chen.sst@gmail.com>
 //
+#include <algorithm>
 #include <fstream>
 #include <boost/algorithm/string.hpp>
 #include <filesystem>
@@ -14,6 +15,7 @@
 #include <rime/dict/db_utils.h>
 #include <rime/dict/table_db.h>
 #include <rime/dict/user_db.h>
+#include <rime/dict/user_db_delta.h>
 #include <rime/lever/user_dict_manager.h>
 
 namespace fs = std::filesystem;
@@ -98,7 +100,7 @@ bool UserDictManager::Restore(const path& snapshot_file) {
   LOG(INFO) << "merging '" << snapshot_file << "' from "
             << UserDbHelper(temp).GetUserId() << " into userdb '" << db_name
             << "'...";
-  DbSource source(temp.get());
+  UserDbSource source(temp.get());
   UserDbMerger merger(dest.get());
   source >> merger;
   return true;
@@ -116,7 +118,7 @@ int UserDictManager::Export(const string& dict_name, const path& text_file) {
     return -1;
   TsvWriter writer(text_file, TableDb::format.formatter);
   writer.file_description = "Rime user dictionary export";
-  DbSource source(db.get());
+  UserDbSource source(db.get());
   int num_entries = 0;
   try {
     num_entries = writer << source;
@@ -175,6 +177,208 @@ bool UserDictManager::UpgradeUserDict(const string& dict_name) {
          legacy_db->Remove() && Restore(snapshot_path);
 }
 
+// a full snapshot is written again after this many delta snapshots
+static const size_t kMaxDeltaSnapshots = 16;
+
+// the last tick of a device's snapshots that have been merged
+static string sync_tick_key(const string& device) {
+  return "/sync_tick/" + device;
+}
+
+// tick count at the end of the last sync
+static const char* kLocalTickKey = "/local_tick";
+
+static TickCount fetch_tick(Db* db, const string& key) {
+  string value;
+  if (db->MetaFetch(key, &value)) {
+    try {
+      return std::stoul(value);
+    } catch (...) {
+    }
+  }
+  return 0;
+}
+
+// reads the tick count from metadata at the top of a snapshot file
+static TickCount get_snapshot_tick(const path& snapshot_file) {
+  std::ifstream fin(snapshot_file.c_str());
+  string line;
+  while (getline(fin, line) && boost::starts_with(line, "#")) {
+    if (boost::starts_with(line, "#@/tick\t")) {
+      try {
+        return std::stoul(line.substr(8));
+      } catch (...) {
+      }
+      break;
+    }
+  }
+  return 0;
+}
+
+struct DeltaSnapshot {
+  path file_path;
+  UserDbDeltaHeader header;
+};
+
+static string delta_snapshot_prefix(const string& dict_name) {
+  return dict_name + ".userdb.";
+}
+
+// lists delta snapshots in a directory in the order of ticks
+static vector<DeltaSnapshot> list_delta_snapshots(const path& dir,
+                                                  const string& dict_name) {
+  vector<DeltaSnapshot> result;
+  const string prefix = delta_snapshot_prefix(dict_name);
+  const string suffix = UserDbDeltaReader::extension();
+  for (fs::directory_iterator it(dir), end; it != end; ++it) {
+    string name = it->path().filename().u8string();
+    if (!boost::starts_with(name, prefix) || !boost::ends_with(name, suffix))
+      continue;
+    DeltaSnapshot delta;
+    delta.file_path = path(it->path());
+    if (UserDbDeltaReader(delta.file_path).ReadHeader(&delta.header)) {
+      result.push_back(delta);
+    } else {
+      LOG(WARNING) << "invalid delta snapshot: " << delta.file_path;
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const DeltaSnapshot& a, const DeltaSnapshot& b) {
+              return a.header.tick < b.header.tick;
+            });
+  return result;
+}
+
+bool UserDictManager::MergeSnapshot(Db* db,
+                                    const path& snapshot_file,
+                                    MergedEntries* merged) {
+  the<Db> temp(user_db_component_->Create(".temp"));
+  if (temp->Exists())
+    temp->Remove();
+  if (!temp->Open())
+    return false;
+  BOOST_SCOPE_EXIT((&temp)) {
+    temp->Close();
+    temp->Remove();
+  }
+  BOOST_SCOPE_EXIT_END
+  if (!temp->Restore(snapshot_file) || !UserDbHelper(temp).IsUserDb())
+    return false;
+  LOG(INFO) << "merging '" << snapshot_file << "' from "
+            << UserDbHelper(temp).GetUserId() << " into userdb '" << db->name()
+            << "'...";
+  UserDbSource source(temp.get());
+  UserDbMerger merger(db);
+  merger.RecordMergedKeys(merged->local_since, &merged->keys);
+  source >> merger;
+  return true;
+}
+
+bool UserDictManager::MergeDeviceSnapshots(Db* db,
+                                           const path& device_dir,
+                                           MergedEntries* merged) {
+  const string device = device_dir.filename().u8string();
+  TickCount synced_tick = fetch_tick(db, sync_tick_key(device));
+  auto deltas = list_delta_snapshots(device_dir, db->name());
+  auto pending = [&] {
+    return std::find_if(deltas.begin(), deltas.end(),
+                        [&](const DeltaSnapshot& delta) {
+                          return delta.header.tick > synced_tick;
+                        });
+  };
+  auto next = pending();
+  bool success = true;
+  // the full snapshot is needed unless the deltas continue from where we were
+  path snapshot_file = device_dir / (db->name() + UserDb::snapshot_extension());
+  if (fs::exists(snapshot_file)) {
+    TickCount snapshot_tick = get_snapshot_tick(snapshot_file);
+    bool continuous =
+        next != deltas.end() && next->header.since_tick <= synced_tick;
+    if (synced_tick == 0 || (snapshot_tick > synced_tick && !continuous)) {
+      LOG(INFO) << "merging snapshot file: " << snapshot_file;
+      if (MergeSnapshot(db, snapshot_file, merged)) {
+        synced_tick = (std::max)(synced_tick, snapshot_tick);
+        next = pending();
+      } else {
+        LOG(ERROR) << "failed to merge snapshot file: " << snapshot_file;
+        success = false;
+      }
+    }
+  }
+  for (; success && next != deltas.end(); ++next) {
+    if (next->header.since_tick > synced_tick) {
+      // an earlier delta is missing, maybe not synced yet; merging later ones
+      // would skip the entries in it for good.
+      LOG(WARNING) << "missing delta snapshot since tick " << synced_tick
+                   << " from " << device;
+      break;
+    }
+    LOG(INFO) << "merging delta snapshot: " << next->file_path;
+    UserDbDeltaReader reader(next->file_path);
+    UserDbMerger merger(db);
+    merger.RecordMergedKeys(merged->local_since, &merged->keys);
+    if ((reader >> merger) < 0) {
+      LOG(ERROR) << "failed to merge delta snapshot: " << next->file_path;
+      success = false;
+      break;
+    }
+    synced_tick = next->header.tick;
+  }
+  db->MetaUpdate(sync_tick_key(device), std::to_string(synced_tick));
+  return success;
+}
+
+bool UserDictManager::BackupDelta(Db* db,
+                                  TickCount local_tick,
+                                  const MergedEntries& merged) {
+  if (UserDbHelper(db).GetUserId() != deployer_->user_id) {
+    LOG(INFO) << "user id not match; updating metadata in " << db->name();
+    if (!UserDbHelper(db).UpdateUserInfo()) {
+      LOG(ERROR) << "failed to update metadata in " << db->name();
+      return false;
+    }
+  }
+  const path& dir(deployer_->user_data_sync_dir());
+  if (!fs::exists(dir)) {
+    std::error_code ec;
+    if (!fs::create_directories(dir, ec)) {
+      LOG(ERROR) << "error creating directory '" << dir << "'.";
+      return false;
+    }
+  }
+  const string key = sync_tick_key(deployer_->user_id);
+  TickCount synced_tick = fetch_tick(db, key);
+  TickCount tick = fetch_tick(db, "/tick");
+  path snapshot_file = dir / (db->name() + UserDb::snapshot_extension());
+  bool full_snapshot = synced_tick == 0 || !fs::exists(snapshot_file);
+  if (!full_snapshot && local_tick <= merged.local_since) {
+    // nothing changed here since the last sync
+    return db->MetaUpdate(kLocalTickKey, std::to_string(tick));
+  }
+  auto deltas = list_delta_snapshots(dir, db->name());
+  if (full_snapshot || deltas.size() >= kMaxDeltaSnapshots) {
+    // write a full snapshot and start a new series of deltas
+    if (!db->Backup(snapshot_file))
+      return false;
+    for (const auto& delta : deltas) {
+      std::error_code ec;
+      fs::remove(delta.file_path, ec);
+    }
+  } else {
+    path delta_file = dir / (delta_snapshot_prefix(db->name()) +
+                             std::to_string(tick) +
+                             UserDbDeltaReader::extension());
+    UserDbDeltaWriter writer(delta_file, synced_tick);
+    // entries merged from other devices are not ours to send back
+    writer.Exclude(merged.local_since, &merged.keys);
+    UserDbSource source(db);
+    if ((writer << source) < 0)
+      return false;
+  }
+  return db->MetaUpdate(key, std::to_string(tick)) &&
+         db->MetaUpdate(kLocalTickKey, std::to_string(tick));
+}
+
 bool UserDictManager::Synchronize(const string& dict_name) {
   LOG(INFO) << "synchronize user dict '" << dict_name << "'.";
   bool success = true;
@@ -186,21 +390,32 @@ bool UserDictManager::Synchronize(const string& dict_name) {
       return false;
     }
   }
-  // *.userdb.txt
-  string snapshot_file = dict_name + UserDb::snapshot_extension();
+  the<Db> db(user_db_component_->Create(dict_name));
+  if (!db->Open() || !UserDbHelper(db).IsUserDb()) {
+    LOG(ERROR) << "error opening user dict '" << dict_name << "'.";
+    return false;
+  }
+  BOOST_SCOPE_EXIT((&db)) {
+    db->Close();
+  }
+  BOOST_SCOPE_EXIT_END
+  // local updates advance the tick count from where the last sync left it
+  TickCount local_tick = fetch_tick(db.get(), "/tick");
+  MergedEntries merged;
+  merged.local_since = fetch_tick(db.get(), kLocalTickKey);
+  if (merged.local_since == 0)  // synced by an earlier version
+    merged.local_since =
+        fetch_tick(db.get(), sync_tick_key(deployer_->user_id));
+  // *.userdb.txt and *.userdb.*.delta
   for (fs::directory_iterator it(sync_dir), end; it != end; ++it) {
     if (!fs::is_directory(it->path()))
       continue;
-    path file_path = path(it->path()) / snapshot_file;
-    if (fs::exists(file_path)) {
-      LOG(INFO) << "merging snapshot file: " << file_path;
-      if (!Restore(file_path)) {
-        LOG(ERROR) << "failed to merge snapshot file: " << file_path;
-        success = false;
-      }
+    if (!MergeDeviceSnapshots(db.get(), path(it->path()), &merged)) {
+      LOG(ERROR) << "failed to merge snapshots from: " << it->path();
+      success = false;
     }
   }
-  if (!Backup(dict_name)) {
+  if (!BackupDelta(db.get(), local_tick, merged)) {
     LOG(ERROR) << "error backing up user dict '" << dict_name << "'.";
     success = false;
   }
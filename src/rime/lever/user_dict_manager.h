@@ -33,10 +33,26 @@ class RIME_DLL UserDictManager {
   // returns num of imported entries, -1 denotes failure
   int Import(const string& dict_name, const path& text_file);
 
+  // merges snapshots from all devices, then writes changes since the last
+  // synchronization as a delta snapshot to this device's sync dir.
   bool Synchronize(const string& dict_name);
   bool SynchronizeAll();
 
  protected:
+  // entries merged from other devices in a sync, not to be sent back
+  struct MergedEntries {
+    // local updates are stamped with later ticks
+    TickCount local_since = 0;
+    // entries merged without local updates
+    set<string> keys;
+  };
+
+  bool MergeSnapshot(Db* db, const path& snapshot_file, MergedEntries* merged);
+  bool MergeDeviceSnapshots(Db* db,
+                            const path& device_dir,
+                            MergedEntries* merged);
+  bool BackupDelta(Db* db, TickCount local_tick, const MergedEntries& merged);
+
   Deployer* deployer_;
   path path_;
   UserDb::Component* user_db_component_;
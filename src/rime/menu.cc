@@ -8,23 +8,56 @@
 #include <iterator>
 #include <rime/filter.h>
 #include <rime/menu.h>
+#include <rime/tracer.h>
 #include <rime/translation.h>
 
 namespace rime {
 
 Menu::Menu() : merged_(new MergedTranslation(candidates_)), result_(merged_) {}
 
+Menu::~Menu() {
+  CancelPrefetch();
+}
+
 void Menu::AddTranslation(an<Translation> translation) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool exhausted = result_->exhausted();
   *merged_ += translation;
+  if (exhausted && !merged_->exhausted() && !filters_.empty()) {
+    // filters do not come back once exhausted; apply them anew to the rest.
+    result_ = merged_;
+    for (Filter* filter : filters_) {
+      ApplyFilter(filter);
+    }
+  }
+  ++version_;
   DLOG(INFO) << merged_->size() << " translations added.";
 }
 
 void Menu::AddFilter(Filter* filter) {
+  filters_.push_back(filter);
+  ApplyFilter(filter);
+}
+
+void Menu::ApplyFilter(Filter* filter) {
+  if (tracer_ && tracer_->enabled()) {
+    string stage = "filter/" + filter->name_space();
+    TraceScope trace(tracer_.get(), stage);
+    result_ = New<TracedTranslation>(filter->Apply(result_, &candidates_),
+                                     tracer_, stage + "/candidates");
+    return;
+  }
   result_ = filter->Apply(result_, &candidates_);
 }
 
 size_t Menu::Prepare(size_t requested) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return DoPrepare(requested);
+}
+
+size_t Menu::DoPrepare(size_t requested) {
   DLOG(INFO) << "preparing " << requested << " candidates.";
+  TraceScope trace(tracer_.get(), "menu/prepare");
   while (candidates_.size() < requested && !result_->exhausted()) {
     if (auto cand = result_->Peek()) {
       candidates_.push_back(cand);
@@ -34,14 +67,45 @@ size_t Menu::Prepare(size_t requested) {
   return candidates_.size();
 }
 
+void Menu::Prefetch(size_t requested) {
+  // the tracer is not thread-safe
+  if (tracer_ && tracer_->enabled())
+    return;
+  if (requested > prefetch_count_)
+    prefetch_count_ = requested;
+  if (prefetch_.valid() && prefetch_.wait_for(std::chrono::seconds(0)) !=
+                               std::future_status::ready)
+    return;
+  // one candidate at a time, so that the menu is never locked for long.
+  prefetch_ = std::async(std::launch::async, [this] {
+    while (!cancel_prefetch_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      size_t count = candidates_.size();
+      if (count >= prefetch_count_ || result_->exhausted())
+        break;
+      if (DoPrepare(count + 1) > count)
+        ++version_;
+    }
+  });
+}
+
+void Menu::CancelPrefetch() {
+  if (!prefetch_.valid())
+    return;
+  cancel_prefetch_ = true;
+  prefetch_.wait();
+  cancel_prefetch_ = false;
+}
+
 Page* Menu::CreatePage(size_t page_size, size_t page_no) {
+  std::lock_guard<std::mutex> lock(mutex_);
   size_t start_pos = page_size * page_no;
   size_t end_pos = start_pos + page_size;
   if (end_pos > candidates_.size()) {
     if (result_->exhausted())
       end_pos = candidates_.size();
     else
-      end_pos = Prepare(end_pos);
+      end_pos = DoPrepare(end_pos);
     if (start_pos >= end_pos)
       return NULL;
     end_pos = (std::min)(start_pos + page_size, end_pos);
@@ -58,13 +122,20 @@ Page* Menu::CreatePage(size_t page_size, size_t page_no) {
 }
 
 an<Candidate> Menu::GetCandidateAt(size_t index) {
-  if (index >= candidates_.size() && index >= Prepare(index + 1)) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index >= candidates_.size() && index >= DoPrepare(index + 1)) {
     return nullptr;
   }
   return candidates_[index];
 }
 
+size_t Menu::candidate_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return candidates_.size();
+}
+
 bool Menu::empty() const {
+  std::lock_guard<std::mutex> lock(mutex_);
   return candidates_.empty() && result_->exhausted();
 }
 
@@ -7,6 +7,9 @@
 #ifndef RIME_MENU_H_
 #define RIME_MENU_H_
 
+#include <atomic>
+#include <future>
+#include <mutex>
 #include <rime_api.h>
 #include <rime/candidate.h>
 #include <rime/common.h>
@@ -22,29 +25,56 @@ struct Page {
 
 class Filter;
 class MergedTranslation;
+class Tracer;
 class Translation;
 
 class Menu {
  public:
   RIME_DLL Menu();
+  RIME_DLL ~Menu();
 
+  // may be called after candidates have been obtained, to merge a late
+  // translation into the rest of the menu.
   RIME_DLL void AddTranslation(an<Translation> translation);
+  // the filter is kept, to be applied again to late translations.
   void AddFilter(Filter* filter);
+  // times filters and candidate preparation; set before adding filters.
+  void set_tracer(an<Tracer> tracer) { tracer_ = tracer; }
 
   RIME_DLL size_t Prepare(size_t candidate_count);
+  // keeps preparing candidates on a worker thread, up to candidate_count,
+  // while the menu is idle. translations and filters must have been added.
+  RIME_DLL void Prefetch(size_t candidate_count);
+  // stops the worker and waits for it; Prefetch() may start it over.
+  RIME_DLL void CancelPrefetch();
   RIME_DLL Page* CreatePage(size_t page_size, size_t page_no);
   an<Candidate> GetCandidateAt(size_t index);
 
   // CAVEAT: returns the number of candidates currently obtained,
   // rather than the total number of available candidates.
-  size_t candidate_count() const { return candidates_.size(); }
+  size_t candidate_count() const;
 
   bool empty() const;
 
+  // changes as translations are added, or as candidates are prepared in the
+  // background.
+  uint64_t version() const { return version_; }
+
  private:
+  size_t DoPrepare(size_t candidate_count);
+  void ApplyFilter(Filter* filter);
+
   an<MergedTranslation> merged_;
   an<Translation> result_;
+  vector<Filter*> filters_;
   CandidateList candidates_;
+  an<Tracer> tracer_;
+  // guards result_ and candidates_ once prefetching has started
+  mutable std::mutex mutex_;
+  std::atomic<size_t> prefetch_count_{0};
+  std::atomic<bool> cancel_prefetch_{false};
+  std::atomic<uint64_t> version_{0};
+  std::future<void> prefetch_;
 };
 
 }  // namespace rime
@@ -34,7 +34,14 @@ void Schema::FetchUsefulConfigItems() {
     page_size_ = 5;
   }
   config_->GetString("menu/alternative_select_keys", &select_keys_);
+  if (auto labels = config_->GetList("menu/alternative_select_labels")) {
+    for (size_t i = 0; i < labels->size(); ++i) {
+      auto value = labels->GetValueAt(i);
+      select_labels_.push_back(value ? value->str() : string());
+    }
+  }
   config_->GetBool("menu/page_down_cycle", &page_down_cycle_);
+  config_->GetInt("menu/prefetch_pages", &prefetch_pages_);
 }
 
 Config* SchemaComponent::Create(const string& schema_id) {
@@ -27,8 +27,10 @@ class Schema {
 
   int page_size() const { return page_size_; }
   bool page_down_cycle() const { return page_down_cycle_; }
+  int prefetch_pages() const { return prefetch_pages_; }
   const string& select_keys() const { return select_keys_; }
   void set_select_keys(const string& keys) { select_keys_ = keys; }
+  const vector<string>& select_labels() const { return select_labels_; }
 
  private:
   void FetchUsefulConfigItems();
@@ -39,7 +41,9 @@ class Schema {
   // frequently used config items
   int page_size_ = 5;
   bool page_down_cycle_ = false;
+  int prefetch_pages_ = 0;
   string select_keys_;
+  vector<string> select_labels_;
 };
 
 class SchemaComponent : public Config::Component {
@@ -6,16 +6,33 @@
 //
 #include <rime/context.h>
 #include <rime/engine.h>
+#include <rime/key_event.h>
 #include <rime/resource.h>
 #include <rime/schema.h>
 #include <rime/service.h>
+#include <rime/tracer.h>
 
 using namespace std::placeholders;
 
 namespace rime {
 
+struct Session::Hibernation {
+  string schema_id;
+  map<string, bool> options;
+  map<string, string> properties;
+  string input;
+  size_t caret_pos = 0;
+  CommitHistory commit_history;
+};
+
 Session::Session() {
   engine_.reset(Engine::Create());
+  ConnectEngine();
+}
+
+Session::~Session() {}
+
+void Session::ConnectEngine() {
   engine_->sink().connect([this](auto text) { OnCommit(text); });
   SessionId session_id = reinterpret_cast<SessionId>(this);
   engine_->message_sink().connect([session_id](auto type, auto value) {
@@ -23,10 +40,65 @@ Session::Session() {
   });
 }
 
+bool Session::Hibernate() {
+  // not while a schema is being selected in the switcher
+  if (!engine_ || engine_->active_engine() != engine_.get())
+    return false;
+  the<Hibernation> hibernation(new Hibernation);
+  hibernation->schema_id = engine_->schema()->schema_id();
+  Context* ctx = engine_->context();
+  hibernation->options = ctx->options();
+  hibernation->properties = ctx->properties();
+  hibernation->input = ctx->input();
+  hibernation->caret_pos = ctx->caret_pos();
+  hibernation->commit_history = ctx->commit_history();
+  engine_.reset();
+  hibernation_ = std::move(hibernation);
+  return true;
+}
+
+bool Session::Wake() {
+  if (!hibernation_)
+    return false;
+  the<Hibernation> hibernation(std::move(hibernation_));
+  engine_.reset(Engine::Create(new Schema(hibernation->schema_id)));
+  // restored before connecting the sinks; the client has seen it all.
+  Context* ctx = engine_->context();
+  for (const auto& option : hibernation->options) {
+    if (ctx->get_option(option.first) != option.second)
+      ctx->set_option(option.first, option.second);
+  }
+  for (const auto& property : hibernation->properties) {
+    ctx->set_property(property.first, property.second);
+  }
+  ctx->commit_history() = std::move(hibernation->commit_history);
+  if (!hibernation->input.empty()) {
+    ctx->set_input(hibernation->input);
+    ctx->set_caret_pos(hibernation->caret_pos);
+  }
+  ConnectEngine();
+  return true;
+}
+
 bool Session::ProcessKey(const KeyEvent& key_event) {
   return engine_->ProcessKey(key_event);
 }
 
+size_t Session::ProcessKeys(const KeySequence& keys, vector<bool>* handled) {
+  size_t num_handled = 0;
+  Context* ctx = engine_->context();
+  ctx->BeginBatch();
+  for (const KeyEvent& key_event : keys) {
+    bool ret = engine_->ProcessKey(key_event);
+    if (ret)
+      ++num_handled;
+    if (handled)
+      handled->push_back(ret);
+  }
+  ctx->EndBatch();
+  return num_handled;
+}
+
 void Session::Activate() {
   last_active_time_ = time(NULL);
 }
@@ -64,6 +136,10 @@ Schema* Session::schema() const {
   return engine_ ? engine_->active_engine()->schema() : NULL;
 }
 
+Tracer* Session::tracer() const {
+  return engine_ ? engine_->tracer().get() : NULL;
+}
+
 Service::Service() {
   deployer_.message_sink().connect(
       [this](auto type, auto value) { Notify(0, type, value); });
@@ -112,11 +188,20 @@ an<Session> Service::GetSession(SessionId session_id) {
   if (it != sessions_.end()) {
     auto& session = it->second;
     session->Activate();
+    if (session->hibernated() && !session->Wake())
+      return nullptr;
     return session;
   }
   return nullptr;
 }
 
+an<Session> Service::PeekSession(SessionId session_id) {
+  if (disabled())
+    return nullptr;
+  auto it = sessions_.find(session_id);
+  return it != sessions_.end() ? it->second : nullptr;
+}
+
 bool Service::DestroySession(SessionId session_id) {
   auto it = sessions_.find(session_id);
   if (it == sessions_.end())
@@ -146,6 +231,23 @@ void Service::CleanupAllSessions() {
   sessions_.clear();
 }
 
+size_t Service::HibernateIdleSessions(int idle_seconds) {
+  time_t now = time(NULL);
+  size_t count = 0;
+  for (auto& entry : sessions_) {
+    auto& session = entry.second;
+    if (session && !session->hibernated() &&
+        session->last_active_time() < now - idle_seconds &&
+        session->Hibernate()) {
+      ++count;
+    }
+  }
+  if (count > 0) {
+    LOG(INFO) << "Hibernated " << count << " idle sessions.";
+  }
+  return count;
+}
+
 void Service::SetNotificationHandler(const NotificationHandler& handler) {
   notification_handler_ = handler;
 }
@@ -26,14 +26,19 @@ using NotificationHandler = function<void(SessionId session_id,
 class Context;
 class Engine;
 class KeyEvent;
+class KeySequence;
 class Schema;
+class Tracer;
 
-class Session {
+class RIME_DLL Session {
  public:
   static const int kLifeSpan = 5 * 60;  // seconds
 
   Session();
+  ~Session();
   bool ProcessKey(const KeyEvent& key_event);
+  // composes once for the batch; returns the number of keys handled.
+  size_t ProcessKeys(const KeySequence& keys, vector<bool>* handled = nullptr);
   void Activate();
   void ResetCommitText();
   bool CommitComposition();
@@ -42,13 +47,23 @@ class Session {
 
   Context* context() const;
   Schema* schema() const;
+  Tracer* tracer() const;
   time_t last_active_time() const { return last_active_time_; }
   const string& commit_text() const { return commit_text_; }
 
+  // releases the engine, keeping just enough state to rebuild it.
+  bool Hibernate();
+  bool Wake();
+  bool hibernated() const { return bool(hibernation_); }
+
  private:
+  struct Hibernation;
+
+  void ConnectEngine();
   void OnCommit(const string& commit_text);
 
   the<Engine> engine_;
+  the<Hibernation> hibernation_;
   time_t last_active_time_ = 0;
   string commit_text_;
 };
@@ -65,9 +80,13 @@ class RIME_DLL Service {
 
   SessionId CreateSession();
   an<Session> GetSession(SessionId session_id);
+  // neither wakes the session up nor keeps it active.
+  an<Session> PeekSession(SessionId session_id);
   bool DestroySession(SessionId session_id);
   void CleanupStaleSessions();
   void CleanupAllSessions();
+  // returns the number of sessions put to hibernation.
+  size_t HibernateIdleSessions(int idle_seconds);
 
   void SetNotificationHandler(const NotificationHandler& handler);
   void ClearNotificationHandler();
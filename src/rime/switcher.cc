@@ -63,6 +63,8 @@ ProcessResult Switcher::ProcessKeyEvent(const KeyEvent& key_event) {
     for (auto& p : processors_) {
       ProcessResult result = p->ProcessKeyEvent(key_event);
       if (result != kNoop) {
+        if (result == kAccepted)
+          context_->MarkChanged();
         return result;
       }
     }
@@ -99,7 +101,7 @@ void Switcher::HighlightNextSchema() {
   } while (!option || option->type() != "schema");
   seg.selected_index = index;
   seg.tags.insert("paging");
-  return;
+  context_->MarkChanged();
 }
 
 /*
@@ -238,6 +240,7 @@ void Switcher::RefreshMenu() {
       menu->AddTranslation(t);
     }
   }
+  context_->MarkChanged();
 }
 
 void Switcher::Activate() {
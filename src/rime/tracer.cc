@@ -0,0 +1,135 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <cstdio>
+#include <fstream>
+#include <rime/tracer.h>
+
+namespace rime {
+
+static uint64_t to_ns(Tracer::Clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+Tracer::Tracer() : epoch_(Clock::now()) {}
+
+void Tracer::Begin(const string& stage) {
+  auto stats = stats_.find(stage);
+  if (stats == stats_.end()) {
+    stats = stats_.emplace(stage, Stats()).first;
+  }
+  stack_.push_back({stats, Clock::now(), 0});
+}
+
+void Tracer::End() {
+  if (stack_.empty())
+    return;
+  auto end = Clock::now();
+  const Frame& frame = stack_.back();
+  uint64_t elapsed = to_ns(end - frame.start);
+  Stats& stats = frame.stats->second;
+  ++stats.count;
+  stats.total_ns += elapsed;
+  stats.self_ns += elapsed > frame.child_ns ? elapsed - frame.child_ns : 0;
+  if (elapsed > stats.max_ns)
+    stats.max_ns = elapsed;
+  Event event{&frame.stats->first, to_ns(frame.start - epoch_), elapsed};
+  if (events_.size() < kMaxTraceEvents) {
+    events_.push_back(event);
+  } else {
+    events_[next_event_ % kMaxTraceEvents] = event;
+  }
+  ++next_event_;
+  stack_.pop_back();
+  if (!stack_.empty()) {
+    stack_.back().child_ns += elapsed;
+  }
+}
+
+void Tracer::Reset() {
+  stack_.clear();
+  events_.clear();
+  next_event_ = 0;
+  stats_.clear();
+  epoch_ = Clock::now();
+}
+
+static string json_escape(const string& str) {
+  string escaped;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      escaped += buffer;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+bool Tracer::DumpTrace(const path& file_path) const {
+  std::ofstream out(file_path.c_str());
+  if (!out) {
+    LOG(ERROR) << "error opening trace file: " << file_path;
+    return false;
+  }
+  out << "{\"traceEvents\":[";
+  // oldest first, if the ring buffer has wrapped around
+  size_t first = events_.size() < kMaxTraceEvents ? 0 : next_event_;
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const Event& event = events_[(first + i) % events_.size()];
+    char times[64];
+    snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f",
+             event.start_ns / 1000.0, event.duration_ns / 1000.0);
+    out << (i ? ",\n" : "\n") << "{\"name\":\"" << json_escape(*event.stage)
+        << "\",\"cat\":\"rime\",\"ph\":\"X\",\"pid\":1,\"tid\":1," << times
+        << "}";
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  out.close();
+  if (!out) {
+    LOG(ERROR) << "error writing trace file: " << file_path;
+    return false;
+  }
+  return true;
+}
+
+TracedTranslation::TracedTranslation(an<Translation> translation,
+                                     an<Tracer> tracer,
+                                     const string& stage)
+    : translation_(translation), tracer_(tracer), stage_(stage) {
+  set_exhausted(!translation_ || translation_->exhausted());
+}
+
+bool TracedTranslation::Next() {
+  if (exhausted())
+    return false;
+  TraceScope trace(tracer_.get(), stage_);
+  bool ret = translation_->Next();
+  set_exhausted(translation_->exhausted());
+  return ret;
+}
+
+an<Candidate> TracedTranslation::Peek() {
+  if (exhausted())
+    return nullptr;
+  TraceScope trace(tracer_.get(), stage_);
+  auto candidate = translation_->Peek();
+  set_exhausted(translation_->exhausted());
+  return candidate;
+}
+
+int TracedTranslation::Compare(an<Translation> other,
+                               const CandidateList& candidates) {
+  if (exhausted())
+    return Translation::Compare(other, candidates);
+  TraceScope trace(tracer_.get(), stage_);
+  return translation_->Compare(other, candidates);
+}
+
+}  // namespace rime
@@ -0,0 +1,105 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#ifndef RIME_TRACER_H_
+#define RIME_TRACER_H_
+
+#include <stdint.h>
+#include <chrono>
+#include <rime_api.h>
+#include <rime/common.h>
+#include <rime/translation.h>
+
+namespace rime {
+
+// Collects timing of the stages an engine goes through on each keystroke.
+// Stages nest, eg. a filter pulls candidates from a translator; the self time
+// of a stage excludes that of the stages nested in it.
+class Tracer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stats {
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t self_ns = 0;
+    uint64_t max_ns = 0;
+  };
+  using StatsMap = map<string, Stats>;
+
+  // the most recent events are kept for the trace file.
+  static const size_t kMaxTraceEvents = 65536;
+
+  RIME_DLL Tracer();
+
+  bool enabled() const { return enabled_; }
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+
+  void Begin(const string& stage);
+  void End();
+
+  const StatsMap& stats() const { return stats_; }
+  RIME_DLL void Reset();
+  // writes recorded events in Chrome trace event format, which can be opened
+  // in chrome://tracing or ui.perfetto.dev.
+  RIME_DLL bool DumpTrace(const path& file_path) const;
+
+ private:
+  struct Frame {
+    StatsMap::iterator stats;
+    Clock::time_point start;
+    uint64_t child_ns;
+  };
+  struct Event {
+    const string* stage;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+  };
+
+  bool enabled_ = false;
+  Clock::time_point epoch_;
+  StatsMap stats_;
+  vector<Frame> stack_;
+  // a ring buffer once it reaches kMaxTraceEvents
+  vector<Event> events_;
+  size_t next_event_ = 0;
+};
+
+// Times the enclosing scope as a stage; does nothing if tracing is disabled.
+class TraceScope {
+ public:
+  TraceScope(Tracer* tracer, const string& stage)
+      : tracer_(tracer && tracer->enabled() ? tracer : nullptr) {
+    if (tracer_)
+      tracer_->Begin(stage);
+  }
+  ~TraceScope() {
+    if (tracer_)
+      tracer_->End();
+  }
+
+ private:
+  Tracer* tracer_;
+};
+
+// Times the candidates pulled lazily from a translation.
+class TracedTranslation : public Translation {
+ public:
+  TracedTranslation(an<Translation> translation,
+                    an<Tracer> tracer,
+                    const string& stage);
+
+  virtual bool Next();
+  virtual an<Candidate> Peek();
+  virtual int Compare(an<Translation> other, const CandidateList& candidates);
+
+ protected:
+  an<Translation> translation_;
+  an<Tracer> tracer_;
+  string stage_;
+};
+
+}  // namespace rime
+
+#endif  // RIME_TRACER_H_
@@ -10,6 +10,7 @@
 
 #include <rime/common.h>
 #include <rime/component.h>
+#include <rime/segmentation.h>
 #include <rime/ticket.h>
 
 namespace rime {
@@ -17,7 +18,6 @@ namespace rime {
 class Context;
 class Engine;
 class Translation;
-struct Segment;
 
 class Translator : public Class<Translator, const Ticket&> {
  public:
@@ -30,6 +30,19 @@ class Translator : public Class<Translator, const Ticket&> {
 
   string name_space() const { return name_space_; }
 
+  // whether Query() can run on a worker thread while the engine goes on;
+  // see engine/concurrent_translators.
+  virtual bool thread_safe() const { return false; }
+  // called on the engine thread for a concurrent translator; reads what the
+  // query needs of the engine, and returns the rest of it to be run on a
+  // worker thread, or an empty function if there is nothing to query.
+  virtual function<an<Translation>()> PrepareQuery(const string& input,
+                                                   const Segment& segment) {
+    return [this, input, segment] { return Query(input, segment); };
+  }
+  // the user dictionary Query() reads and learning writes to, if any.
+  virtual string user_dict_name() const { return string(); }
+
  protected:
   Engine* engine_;
   string name_space_;
@@ -116,6 +116,11 @@ typedef struct rime_traits_t {
   const char* staging_dir;
 } RimeTraits;
 
+typedef struct rime_key_event_t {
+  int keycode;
+  int mask;
+} RimeKeyEvent;
+
 typedef struct {
   int length;
   int cursor_pos;
@@ -162,6 +167,53 @@ typedef struct RIME_FLAVORED(rime_context_t) {
   char** select_labels;
 } RIME_FLAVORED(RimeContext);
 
+//! a string in the buffer of a RimeContextView
+typedef struct rime_text_ref_t {
+  //! byte offset of the NUL-terminated string in the buffer
+  uint32_t offset;
+  //! 0 for an empty or absent string
+  uint32_t length;
+} RimeTextRef;
+
+typedef struct rime_candidate_ref_t {
+  RimeTextRef text;
+  RimeTextRef comment;
+} RimeCandidateRef;
+
+/*!
+ *  Context serialized into a buffer owned by the caller; nothing to free.
+ *  Should be initialized by calling RIME_STRUCT_INIT(Type, var);
+ */
+typedef struct RIME_FLAVORED(rime_context_view_t) {
+  int data_size;
+  //! in: generation of the context the caller already has, or 0.
+  //! out: generation of the current context.
+  uint64_t generation;
+  //! False if the context is of the given generation; then nothing else in
+  //! the view or the buffer is written.
+  Bool changed;
+  //! bytes of the buffer required.
+  size_t buffer_used;
+  // composition
+  RimeTextRef preedit;
+  int cursor_pos;
+  int sel_start;
+  int sel_end;
+  RimeTextRef commit_text_preview;
+  // menu
+  int page_size;
+  int page_no;
+  Bool is_last_page;
+  int highlighted_candidate_index;
+  int num_candidates;
+  //! offset of RimeCandidateRef[num_candidates] in the buffer
+  uint32_t candidates;
+  RimeTextRef select_keys;
+  //! offset of RimeTextRef[page_size] in the buffer, if has_select_labels
+  uint32_t select_labels;
+  Bool has_select_labels;
+} RIME_FLAVORED(RimeContextView);
+
 /*!
  *  Should be initialized by calling RIME_STRUCT_INIT(Type, var);
  */
@@ -213,6 +265,22 @@ typedef struct rime_string_slice_t {
   size_t length;
 } RimeStringSlice;
 
+//! timing of an engine stage, eg. "translator/translator", "filter/simplifier"
+typedef struct rime_trace_stat_t {
+  char* stage;
+  size_t count;
+  //! including nested stages
+  double total_ms;
+  //! excluding nested stages
+  double self_ms;
+  double max_ms;
+} RimeTraceStat;
+
+typedef struct rime_trace_stats_t {
+  size_t size;
+  RimeTraceStat* list;
+} RimeTraceStats;
+
 /*!
  * - on loading schema:
  *   + message_type="schema", message_value="luna_pinyin/Luna Pinyin"
@@ -505,6 +573,47 @@ typedef struct RIME_FLAVORED(rime_api_t) {
                                               size_t index);
 
   Bool (*change_page)(RimeSessionId session_id, Bool backward);
+
+  //! per-stage timing of the engine, off by default.
+  Bool (*set_tracing)(RimeSessionId session_id, Bool enabled);
+  //! stages are sorted by name; release with free_trace_stats.
+  Bool (*get_trace_stats)(RimeSessionId session_id, RimeTraceStats* stats);
+  void (*free_trace_stats)(RimeTraceStats* stats);
+  void (*reset_trace_stats)(RimeSessionId session_id);
+  //! write recent trace events as a Chrome trace (JSON), which can be viewed
+  //! in chrome://tracing or ui.perfetto.dev.
+  Bool (*dump_trace)(RimeSessionId session_id, const char* file_path);
+
+  //! process a burst of keys, composing once at the end of the batch.
+  //! if handled is not NULL, it receives a result for each key.
+  //! \return the number of keys handled
+  size_t (*process_keys)(RimeSessionId session_id,
+                         const RimeKeyEvent* keys,
+                         size_t count,
+                         Bool* handled);
+
+  //! serialize the context into a caller-provided buffer, which should be
+  //! aligned for uint32_t. no allocation is made; nothing needs freeing.
+  //! \return False if the session is not found, or if the buffer is too
+  //!   small, in which case view->buffer_used is the size required.
+  Bool (*get_context_view)(RimeSessionId session_id,
+                           RIME_FLAVORED(RimeContextView) * view,
+                           char* buffer,
+                           size_t buffer_size);
+
+  //! release the engines of sessions idle for idle_seconds, keeping their
+  //! schema, options, properties, input and commit history. a hibernated
+  //! session is rebuilt when next used through the API.
+  //! \return the number of sessions put to hibernation
+  size_t (*hibernate_idle_sessions)(int idle_seconds);
+
+  //! load the dictionaries and user dictionaries of the given schemas on the
+  //! deployer's work thread, and read their mapped files ahead.
+  //! if pin is True, they stay loaded without a session using them until
+  //! pinned again, eg. with an empty list.
+  Bool (*preload_schemas)(const char* const* schema_ids,
+                          size_t count,
+                          Bool pin);
 } RIME_FLAVORED(RimeApi);
 
 //! API entry
@@ -17,6 +17,7 @@
 #include <rime/setup.h>
 #include <rime/signature.h>
 #include <rime/switches.h>
+#include <rime/tracer.h>
 
 using namespace rime;
 
@@ -55,8 +56,16 @@ RIME_DEPRECATED void RimeInitialize(RimeTraits* traits) {
   Service::instance().StartService();
 }
 
+// closes user dbs kept open by preload_schemas(), eg. before syncing them.
+static void ReleasePinnedResources() {
+  if (DeploymentTask::Require("pin_resources")) {
+    Service::instance().deployer().RunTask("pin_resources", vector<string>());
+  }
+}
+
 RIME_DEPRECATED void RimeFinalize() {
   Service::instance().deployer().JoinMaintenanceThread();
+  ReleasePinnedResources();
   Service::instance().StopService();
   Registry::instance().Clear();
   ModuleManager::instance().UnloadModules();
@@ -81,6 +90,7 @@ RIME_DEPRECATED Bool RimeStartMaintenance(Bool full_check) {
     }
     LOG(INFO) << "changes detected; starting maintenance.";
   }
+  ReleasePinnedResources();
   deployer.ScheduleTask("workspace_update");
   deployer.ScheduleTask("user_dict_upgrade");
   deployer.ScheduleTask("cleanup_trash");
@@ -137,6 +147,7 @@ RIME_DEPRECATED Bool RimeDeployConfigFile(const char* file_name,
 
 RIME_DEPRECATED Bool RimeSyncUserData() {
   Service::instance().CleanupAllSessions();
+  ReleasePinnedResources();
   Deployer& deployer(Service::instance().deployer());
   deployer.ScheduleTask("installation_update");
   deployer.ScheduleTask("backup_config_files");
@@ -151,7 +162,7 @@ RIME_DEPRECATED RimeSessionId RimeCreateSession() {
 }
 
 RIME_DEPRECATED Bool RimeFindSession(RimeSessionId session_id) {
-  return Bool(session_id && Service::instance().GetSession(session_id));
+  return Bool(session_id && Service::instance().PeekSession(session_id));
 }
 
 RIME_DEPRECATED Bool RimeDestroySession(RimeSessionId session_id) {
@@ -166,6 +177,29 @@ RIME_DEPRECATED void RimeCleanupAllSessions() {
   Service::instance().CleanupAllSessions();
 }
 
+static size_t RimeHibernateIdleSessions(int idle_seconds) {
+  return Service::instance().HibernateIdleSessions(idle_seconds);
+}
+
+static Bool RimePreloadSchemas(const char* const* schema_ids,
+                               size_t count,
+                               Bool pin) {
+  if (count && !schema_ids)
+    return False;
+  vector<string> schemas;
+  for (size_t i = 0; i < count; ++i) {
+    if (schema_ids[i])
+      schemas.push_back(schema_ids[i]);
+  }
+  Deployer& deployer(Service::instance().deployer());
+  if (!deployer.ScheduleTask(pin ? "pin_resources" : "preload_resources",
+                             schemas))
+    return False;
+  if (!deployer.IsWorking())
+    deployer.StartWork();
+  return True;
+}
+
 // input
 
 RIME_DEPRECATED Bool RimeProcessKey(RimeSessionId session_id,
@@ -214,7 +248,7 @@ RIME_DEPRECATED Bool RimeGetContext(RimeSessionId session_id,
   an<Session> session(Service::instance().GetSession(session_id));
   if (!session)
     return False;
-  Context* ctx = session->context();
+  const Context* ctx = session->context();
   if (!ctx)
     return False;
   if (ctx->IsComposing()) {
@@ -234,7 +268,7 @@ RIME_DEPRECATED Bool RimeGetContext(RimeSessionId session_id,
     }
   }
   if (ctx->HasMenu()) {
-    Segment& seg(ctx->composition().back());
+    const Segment& seg(ctx->composition().back());
     int page_size = 5;
     Schema* schema = session->schema();
     if (schema)
@@ -264,14 +298,11 @@ RIME_DEPRECATED Bool RimeGetContext(RimeSessionId session_id,
           context->menu.select_keys = new char[select_keys.length() + 1];
           std::strcpy(context->menu.select_keys, select_keys.c_str());
         }
-        Config* config = schema->config();
-        an<ConfigList> select_labels =
-            config->GetList("menu/alternative_select_labels");
-        if (select_labels && (size_t)page_size <= select_labels->size()) {
+        const auto& select_labels = schema->select_labels();
+        if ((size_t)page_size <= select_labels.size()) {
           context->select_labels = new char*[page_size];
           for (size_t i = 0; i < (size_t)page_size; ++i) {
-            an<ConfigValue> value = select_labels->GetValueAt(i);
-            string label = value->str();
+            const string& label = select_labels[i];
             context->select_labels[i] = new char[label.length() + 1];
             std::strcpy(context->select_labels[i], label.c_str());
           }
@@ -306,12 +337,135 @@ RIME_DEPRECATED Bool RimeFreeContext(RIME_FLAVORED(RimeContext) * context) {
   return True;
 }
 
+// lays out arrays and strings in a caller-provided buffer; sizes everything
+// but writes only what fits.
+class ContextViewBuffer {
+ public:
+  ContextViewBuffer(char* data, size_t size) : data_(data), size_(size) {}
+
+  uint32_t Allocate(size_t bytes, size_t alignment) {
+    used_ = (used_ + alignment - 1) / alignment * alignment;
+    size_t offset = used_;
+    used_ += bytes;
+    return uint32_t(offset);
+  }
+
+  template <class T>
+  T* At(uint32_t offset, size_t count) {
+    if (!data_ || offset + sizeof(T) * count > size_)
+      return nullptr;
+    return reinterpret_cast<T*>(data_ + offset);
+  }
+
+  RimeTextRef Write(const string& str) {
+    RimeTextRef ref = {0, 0};
+    if (str.empty())
+      return ref;
+    ref.offset = Allocate(str.length() + 1, 1);
+    ref.length = uint32_t(str.length());
+    if (char* dest = At<char>(ref.offset, str.length() + 1))
+      std::memcpy(dest, str.c_str(), str.length() + 1);
+    return ref;
+  }
+
+  size_t used() const { return used_; }
+  bool overflow() const { return used_ > size_; }
+
+ private:
+  char* data_;
+  size_t size_;
+  size_t used_ = 0;
+};
+
+static Bool RimeGetContextView(RimeSessionId session_id,
+                               RIME_FLAVORED(RimeContextView) * view,
+                               char* buffer,
+                               size_t buffer_size) {
+  if (!view || view->data_size <= 0)
+    return False;
+  an<Session> session(Service::instance().GetSession(session_id));
+  if (!session)
+    return False;
+  const Context* ctx = session->context();
+  if (!ctx)
+    return False;
+  uint64_t generation = ctx->generation();
+  if (view->generation != 0 && view->generation == generation) {
+    view->changed = False;
+    return True;
+  }
+  uint64_t known_generation = view->generation;
+  RIME_STRUCT_CLEAR(*view);
+  view->generation = known_generation;
+  ContextViewBuffer out(buffer, buffer_size);
+  if (ctx->IsComposing()) {
+    Preedit preedit = ctx->GetPreedit();
+    view->preedit = out.Write(preedit.text);
+    view->cursor_pos = preedit.caret_pos;
+    view->sel_start = preedit.sel_start;
+    view->sel_end = preedit.sel_end;
+    view->commit_text_preview = out.Write(ctx->GetCommitText());
+  }
+  if (ctx->HasMenu()) {
+    const Segment& seg(ctx->composition().back());
+    int page_size = 5;
+    Schema* schema = session->schema();
+    if (schema)
+      page_size = schema->page_size();
+    int selected_index = seg.selected_index;
+    int page_no = selected_index / page_size;
+    the<Page> page(seg.menu->CreatePage(page_size, page_no));
+    if (page) {
+      view->page_size = page_size;
+      view->page_no = page_no;
+      view->is_last_page = Bool(page->is_last_page);
+      view->highlighted_candidate_index = selected_index % page_size;
+      if (!ctx->get_option("_hide_candidate")) {
+        size_t num_candidates = page->candidates.size();
+        view->num_candidates = int(num_candidates);
+        view->candidates = out.Allocate(
+            sizeof(RimeCandidateRef) * num_candidates, alignof(uint32_t));
+        for (size_t i = 0; i < num_candidates; ++i) {
+          const auto& cand = page->candidates[i];
+          RimeCandidateRef ref = {out.Write(cand->text()),
+                                  out.Write(cand->comment())};
+          if (auto* dest = out.At<RimeCandidateRef>(view->candidates,
+                                                    num_candidates))
+            dest[i] = ref;
+        }
+        if (schema) {
+          view->select_keys = out.Write(schema->select_keys());
+          const auto& select_labels = schema->select_labels();
+          if ((size_t)page_size <= select_labels.size()) {
+            view->has_select_labels = True;
+            view->select_labels = out.Allocate(
+                sizeof(RimeTextRef) * page_size, alignof(uint32_t));
+            for (int i = 0; i < page_size; ++i) {
+              RimeTextRef ref = out.Write(select_labels[i]);
+              if (auto* dest =
+                      out.At<RimeTextRef>(view->select_labels, page_size))
+                dest[i] = ref;
+            }
+          }
+        }
+      }
+    }
+  }
+  view->buffer_used = out.used();
+  if (out.overflow())
+    return False;
+  view->generation = generation;
+  view->changed = True;
+  return True;
+}
+
 RIME_DEPRECATED Bool RimeGetCommit(RimeSessionId session_id,
                                    RimeCommit* commit) {
   if (!commit)
     return False;
   RIME_STRUCT_CLEAR(*commit);
-  an<Session> session(Service::instance().GetSession(session_id));
+  // the commit text outlives the engine of a hibernated session
+  an<Session> session(Service::instance().PeekSession(session_id));
   if (!session)
     return False;
   const string& commit_text(session->commit_text());
@@ -378,7 +532,7 @@ RimeCandidateListFromIndex(RimeSessionId session_id,
   an<Session> session(Service::instance().GetSession(session_id));
   if (!session)
     return False;
-  Context* ctx = session->context();
+  const Context* ctx = session->context();
   if (!ctx || !ctx->HasMenu())
     return False;
   memset(iterator, 0, sizeof(RimeCandidateListIterator));
@@ -776,9 +930,7 @@ RIME_DEPRECATED Bool RimeSimulateKeySequence(RimeSessionId session_id,
     LOG(ERROR) << "error parsing input: '" << key_sequence << "'";
     return False;
   }
-  for (const KeyEvent& key : keys) {
-    session->ProcessKey(key);
-  }
+  session->ProcessKeys(keys);
   return True;
 }
 
@@ -1122,6 +1274,94 @@ static const char* RimeGetStateLabel(RimeSessionId session_id,
       .str;
 }
 
+static size_t RimeProcessKeys(RimeSessionId session_id,
+                              const RimeKeyEvent* keys,
+                              size_t count,
+                              Bool* handled) {
+  if (!keys || count == 0)
+    return 0;
+  an<Session> session(Service::instance().GetSession(session_id));
+  if (!session)
+    return 0;
+  KeySequence key_sequence;
+  key_sequence.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    key_sequence.push_back(KeyEvent(keys[i].keycode, keys[i].mask));
+  }
+  vector<bool> results;
+  size_t num_handled =
+      session->ProcessKeys(key_sequence, handled ? &results : nullptr);
+  if (handled) {
+    for (size_t i = 0; i < results.size(); ++i) {
+      handled[i] = Bool(results[i]);
+    }
+  }
+  return num_handled;
+}
+
+static Bool RimeSetTracing(RimeSessionId session_id, Bool enabled) {
+  an<Session> session(Service::instance().GetSession(session_id));
+  if (!session || !session->tracer())
+    return False;
+  session->tracer()->set_enabled(bool(enabled));
+  return True;
+}
+
+static Bool RimeGetTraceStats(RimeSessionId session_id,
+                              RimeTraceStats* output) {
+  if (!output)
+    return False;
+  output->size = 0;
+  output->list = NULL;
+  an<Session> session(Service::instance().GetSession(session_id));
+  if (!session || !session->tracer())
+    return False;
+  const auto& stats = session->tracer()->stats();
+  if (stats.empty())
+    return True;
+  output->list = new RimeTraceStat[stats.size()];
+  for (const auto& entry : stats) {
+    RimeTraceStat& x(output->list[output->size]);
+    x.stage = new char[entry.first.length() + 1];
+    strcpy(x.stage, entry.first.c_str());
+    x.count = entry.second.count;
+    x.total_ms = entry.second.total_ns / 1e6;
+    x.self_ms = entry.second.self_ns / 1e6;
+    x.max_ms = entry.second.max_ns / 1e6;
+    ++output->size;
+  }
+  return True;
+}
+
+static void RimeFreeTraceStats(RimeTraceStats* stats) {
+  if (!stats)
+    return;
+  if (stats->list) {
+    for (size_t i = 0; i < stats->size; ++i) {
+      delete[] stats->list[i].stage;
+    }
+    delete[] stats->list;
+  }
+  stats->size = 0;
+  stats->list = NULL;
+}
+
+static void RimeResetTraceStats(RimeSessionId session_id) {
+  an<Session> session(Service::instance().GetSession(session_id));
+  if (!session || !session->tracer())
+    return;
+  session->tracer()->Reset();
+}
+
+static Bool RimeDumpTrace(RimeSessionId session_id, const char* file_path) {
+  if (!file_path)
+    return False;
+  an<Session> session(Service::instance().GetSession(session_id));
+  if (!session || !session->tracer())
+    return False;
+  return Bool(session->tracer()->DumpTrace(path(file_path)));
+}
+
 void RimeGetSharedDataDirSecure(char* dir, size_t buffer_size);
 void RimeGetUserDataDirSecure(char* dir, size_t buffer_size);
 void RimeGetPrebuiltDataDirSecure(char* dir, size_t buffer_size);
@@ -1232,6 +1472,15 @@ RIME_API RIME_FLAVORED(RimeApi) * RIME_FLAVORED(rime_get_api)() {
     s_api.highlight_candidate_on_current_page =
         &RimeHighlightCandidateOnCurrentPage;
     s_api.change_page = &RimeChangePage;
+    s_api.set_tracing = &RimeSetTracing;
+    s_api.get_trace_stats = &RimeGetTraceStats;
+    s_api.free_trace_stats = &RimeFreeTraceStats;
+    s_api.reset_trace_stats = &RimeResetTraceStats;
+    s_api.dump_trace = &RimeDumpTrace;
+    s_api.process_keys = &RimeProcessKeys;
+    s_api.get_context_view = &RimeGetContextView;
+    s_api.hibernate_idle_sessions = &RimeHibernateIdleSessions;
+    s_api.preload_schemas = &RimePreloadSchemas;
   }
   return &s_api;
 }
@@ -76,3 +76,41 @@ TEST(RimeAlgebraTest, Projection) {
   EXPECT_EQ(rime::kAbbreviation, s["sh"][0].properties.type);
   EXPECT_DOUBLE_EQ(log(0.5), s["sh"][0].properties.credibility);
 }
+
+TEST(RimeAlgebraTest, ParallelProjection) {
+  auto c = rime::New<rime::ConfigList>();
+  for (int i = 0; i < kNumOfInstructions; ++i) {
+    c->Append(rime::New<rime::ConfigValue>(kInstructions[i]));
+  }
+  rime::Script serial;
+  const char* initials[] = {"b", "c", "ch", "s", "sh", "w", "z", "zh"};
+  for (const char* initial : initials) {
+    for (int i = 0; i < 1000; ++i) {
+      rime::string final("ang");
+      for (int n = i; n > 0; n /= 26) {
+        final += char('a' + n % 26);
+      }
+      serial.AddSyllable(initial + final + std::to_string(i % 5));
+    }
+  }
+  rime::Script parallel(serial);
+
+  rime::Projection p;
+  ASSERT_TRUE(p.Load(c));
+  EXPECT_TRUE(p.Apply(&serial));
+  p.set_num_threads(4);
+  EXPECT_TRUE(p.Apply(&parallel));
+
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (const auto& x : serial) {
+    auto y = parallel.find(x.first);
+    ASSERT_TRUE(y != parallel.end());
+    ASSERT_EQ(x.second.size(), y->second.size());
+    for (size_t i = 0; i < x.second.size(); ++i) {
+      EXPECT_EQ(x.second[i].str, y->second[i].str);
+      EXPECT_EQ(x.second[i].properties.type, y->second[i].properties.type);
+      EXPECT_DOUBLE_EQ(x.second[i].properties.credibility,
+                       y->second[i].properties.credibility);
+    }
+  }
+}
@@ -77,3 +77,39 @@ TEST(RimeCalculusTest, Abbreviation) {
   EXPECT_EQ(rime::kAbbreviation, s.properties.type);
   EXPECT_DOUBLE_EQ(log(0.5), s.properties.credibility);
 }
+
+TEST(RimeCalculusTest, LiteralTransformation) {
+  rime::Calculus calc;
+  rime::the<rime::Calculation> c(calc.Parse("xform/iu/iou/"));
+  ASSERT_TRUE(bool(c));
+  rime::Spelling s("liuliu");
+  EXPECT_TRUE(c->Apply(&s));
+  EXPECT_EQ("liouliou", s.str);
+  rime::the<rime::Calculation> prefix(calc.Parse("xform/^zh/Z/"));
+  ASSERT_TRUE(bool(prefix));
+  s.str = "zhuzh";
+  EXPECT_TRUE(prefix->Apply(&s));
+  EXPECT_EQ("Zuzh", s.str);
+  rime::the<rime::Calculation> suffix(calc.Parse("xform/ng$/N/"));
+  ASSERT_TRUE(bool(suffix));
+  s.str = "ngang";
+  EXPECT_TRUE(suffix->Apply(&s));
+  EXPECT_EQ("ngaN", s.str);
+  rime::the<rime::Calculation> whole(calc.Parse("derive/^lue$/lve/"));
+  ASSERT_TRUE(bool(whole));
+  s.str = "lue";
+  EXPECT_TRUE(whole->Apply(&s));
+  EXPECT_EQ("lve", s.str);
+  // non-matching case
+  s.str = "luen";
+  EXPECT_FALSE(whole->Apply(&s));
+}
+
+TEST(RimeCalculusTest, NonAsciiTransliteration) {
+  rime::Calculus calc;
+  rime::the<rime::Calculation> c(calc.Parse("xlit/vü/üv/"));
+  ASSERT_TRUE(bool(c));
+  rime::Spelling s("lvnü");
+  EXPECT_TRUE(c->Apply(&s));
+  EXPECT_EQ("lünv", s.str);
+}
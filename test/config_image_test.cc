@@ -0,0 +1,135 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <gtest/gtest.h>
+#include <rime/config.h>
+#include <rime/config/config_data.h>
+#include <rime/config/config_image.h>
+
+using namespace rime;
+
+class RimeConfigImageTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    std::filesystem::copy_file(
+        path{"config_test.yaml"}, file_path_,
+        std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::remove(ConfigImage::ImagePath(file_path_));
+    ConfigData data;
+    ASSERT_TRUE(data.LoadFromFile(file_path_, nullptr));
+    ASSERT_TRUE(data.SaveToImage(file_path_));
+  }
+
+  virtual void TearDown() {
+    std::filesystem::remove(file_path_);
+    std::filesystem::remove(ConfigImage::ImagePath(file_path_));
+  }
+
+  path file_path_{"config_image_test.yaml"};
+};
+
+TEST_F(RimeConfigImageTest, LoadFromImage) {
+  auto data = New<ConfigData>();
+  ASSERT_TRUE(data->LoadFromImage(file_path_));
+  Config config(data);
+  string str;
+  EXPECT_TRUE(config.GetString("protoss/residence", &str));
+  EXPECT_EQ("Aiur", str);
+  EXPECT_TRUE(config.GetString("/terrans/tank/cost/time", &str));
+  EXPECT_EQ("30 seconds", str);
+  EXPECT_TRUE(config.GetString("protoss/air_force/@3", &str));
+  EXPECT_EQ("arbiter", str);
+  EXPECT_TRUE(config.GetString("protoss/air_force/@last", &str));
+  EXPECT_EQ("arbiter", str);
+  int value = 0;
+  EXPECT_TRUE(config.GetInt("terrans/supply/produced", &value));
+  EXPECT_EQ(28, value);
+  bool flag = false;
+  EXPECT_TRUE(config.GetBool("zerg/lurker/burrowed", &flag));
+  EXPECT_TRUE(flag);
+  EXPECT_EQ(4, config.GetListSize("protoss/air_force"));
+  EXPECT_TRUE(config.IsNull("protoss/tank"));
+  EXPECT_TRUE(config.IsNull("protoss/air_force/@4"));
+}
+
+TEST_F(RimeConfigImageTest, ModifyLoadedConfig) {
+  auto data = New<ConfigData>();
+  ASSERT_TRUE(data->LoadFromImage(file_path_));
+  Config config(data);
+  EXPECT_TRUE(config.SetString("protoss/residence", "Shakuras"));
+  EXPECT_TRUE(config.SetItem("terrans/tank", nullptr));
+  string str;
+  EXPECT_TRUE(config.GetString("protoss/residence", &str));
+  EXPECT_EQ("Shakuras", str);
+  EXPECT_TRUE(config.IsNull("terrans/tank/cost/time"));
+}
+
+TEST_F(RimeConfigImageTest, ModifyItemsDirectly) {
+  auto data = New<ConfigData>();
+  ASSERT_TRUE(data->LoadFromImage(file_path_));
+  Config config(data);
+  string str;
+  EXPECT_TRUE(config.GetString("terrans/tank/cost/time", &str));
+  auto tank = config.GetMap("terrans/tank");
+  ASSERT_TRUE(bool(tank));
+  auto cost = New<ConfigMap>();
+  cost->Set("time", New<ConfigValue>("45 seconds"));
+  tank->Set("cost", cost);
+  EXPECT_TRUE(config.GetString("terrans/tank/cost/time", &str));
+  EXPECT_EQ("45 seconds", str);
+  auto air_force = config.GetList("protoss/air_force");
+  ASSERT_TRUE(bool(air_force));
+  air_force->Clear();
+  EXPECT_TRUE(config.IsNull("protoss/air_force/@3"));
+  EXPECT_EQ(0, config.GetListSize("protoss/air_force"));
+  // the items handed out are part of the tree
+  data->LoadTree();
+  auto terrans = As<ConfigMap>(As<ConfigMap>(data->root)->Get("terrans"));
+  ASSERT_TRUE(bool(terrans));
+  EXPECT_EQ(tank, terrans->Get("tank"));
+  EXPECT_TRUE(config.GetString("terrans/tank/cost/time", &str));
+  EXPECT_EQ("45 seconds", str);
+}
+
+TEST_F(RimeConfigImageTest, StaleImage) {
+  {
+    std::ofstream out(file_path_.c_str(), std::ios::app);
+    out << "terran: {}" << std::endl;
+  }
+  ConfigData data;
+  EXPECT_FALSE(data.LoadFromImage(file_path_));
+  EXPECT_FALSE(bool(data.root));
+}
+
+TEST_F(RimeConfigImageTest, ConcurrentReaders) {
+  auto data = New<ConfigData>();
+  ASSERT_TRUE(data->LoadFromImage(file_path_));
+  // items are created as they are looked up, and the tree is loaded at last,
+  // while other threads are reading.
+  vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([data] {
+      Config config(data);
+      for (int j = 0; j < 100; ++j) {
+        string str;
+        EXPECT_TRUE(config.GetString("protoss/residence", &str));
+        EXPECT_EQ("Aiur", str);
+        EXPECT_TRUE(config.GetString("terrans/tank/cost/time", &str));
+        EXPECT_EQ("30 seconds", str);
+        EXPECT_EQ(4, config.GetListSize("protoss/air_force"));
+      }
+    });
+  }
+  data->LoadTree();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  Config config(data);
+  string str;
+  EXPECT_TRUE(config.GetString("protoss/air_force/@last", &str));
+  EXPECT_EQ("arbiter", str);
+}
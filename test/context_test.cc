@@ -0,0 +1,105 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <gtest/gtest.h>
+#include <rime/candidate.h>
+#include <rime/context.h>
+#include <rime/menu.h>
+#include <rime/translation.h>
+
+using namespace rime;
+
+class RimeContextTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    ctx_.update_notifier().connect([this](Context* ctx) {
+      ++updates_;
+      // what an engine would do
+      ctx->composition().Reset(ctx->input());
+    });
+  }
+
+  Context ctx_;
+  int updates_ = 0;
+};
+
+TEST_F(RimeContextTest, UpdateOnEachEdit) {
+  ctx_.PushInput('a');
+  ctx_.PushInput('b');
+  EXPECT_EQ(2, updates_);
+}
+
+TEST_F(RimeContextTest, BatchUpdate) {
+  ctx_.BeginBatch();
+  ctx_.PushInput('a');
+  ctx_.PushInput('b');
+  ctx_.PopInput();
+  ctx_.PushInput("cd");
+  EXPECT_EQ(0, updates_);
+  EXPECT_EQ("acd", ctx_.input());
+  ctx_.EndBatch();
+  EXPECT_EQ(1, updates_);
+  EXPECT_EQ("acd", ctx_.composition().input());
+  EXPECT_EQ(1, updates_);
+}
+
+TEST_F(RimeContextTest, UpdateOnDemandInBatch) {
+  ctx_.BeginBatch();
+  ctx_.PushInput('a');
+  // reading the composition brings it up to date
+  EXPECT_FALSE(ctx_.HasMenu());
+  EXPECT_EQ(1, updates_);
+  EXPECT_EQ("a", ctx_.composition().input());
+  ctx_.PushInput('b');
+  ctx_.EndBatch();
+  EXPECT_EQ(2, updates_);
+  EXPECT_EQ("ab", ctx_.composition().input());
+}
+
+TEST_F(RimeContextTest, NestedBatch) {
+  ctx_.BeginBatch();
+  ctx_.BeginBatch();
+  ctx_.PushInput('a');
+  ctx_.EndBatch();
+  EXPECT_EQ(0, updates_);
+  EXPECT_TRUE(ctx_.in_batch());
+  ctx_.EndBatch();
+  EXPECT_EQ(1, updates_);
+  EXPECT_FALSE(ctx_.in_batch());
+}
+
+TEST_F(RimeContextTest, Generation) {
+  uint64_t generation = ctx_.generation();
+  EXPECT_NE(0, generation);
+  EXPECT_EQ(generation, ctx_.generation());
+  ctx_.PushInput('a');
+  uint64_t after_input = ctx_.generation();
+  EXPECT_NE(generation, after_input);
+  EXPECT_EQ(after_input, ctx_.generation());
+  ctx_.set_option("ascii_mode", true);
+  uint64_t after_option = ctx_.generation();
+  EXPECT_NE(after_input, after_option);
+  // reading the composition is not a change
+  EXPECT_TRUE(ctx_.composition().empty());
+  EXPECT_EQ(after_option, ctx_.generation());
+  ctx_.MarkChanged();
+  EXPECT_NE(after_option, ctx_.generation());
+  Context other;
+  EXPECT_NE(ctx_.generation(), other.generation());
+}
+
+TEST_F(RimeContextTest, GenerationChangesAsMenuGrows) {
+  ctx_.PushInput('a');
+  auto menu = New<Menu>();
+  Segment segment(0, 1);
+  segment.menu = menu;
+  ctx_.composition().AddSegment(segment);
+  uint64_t generation = ctx_.generation();
+  EXPECT_EQ(generation, ctx_.generation());
+  // eg. a late translation from a concurrent translator
+  auto translation = New<FifoTranslation>();
+  translation->Append(New<SimpleCandidate>("abc", 0, 1, "A"));
+  menu->AddTranslation(translation);
+  EXPECT_NE(generation, ctx_.generation());
+}
@@ -156,3 +156,43 @@ TEST_F(RimeCorrectorTest, CaseMultipleEdges1) {
   ASSERT_FALSE(sp2.end() == sp2.find(syllable_id_["jue"]));
   ASSERT_TRUE(sp2[syllable_id_["jue"]].type == rime::kNormalSpelling);
 }
+
+TEST_F(RimeCorrectorTest, CaseResumeSearch) {
+  rime::corrector::Corrections corrections;
+  // the second search resumes from the first one
+  corrector_->ToleranceSearch(*prism_, "ju", &corrections, 1);
+  corrector_->ToleranceSearch(*prism_, "juw", &corrections, 1);
+  ASSERT_FALSE(corrections.end() == corrections.find(syllable_id_["jue"]));
+  EXPECT_EQ(1, corrections[syllable_id_["jue"]].distance);
+  EXPECT_EQ(3, corrections[syllable_id_["jue"]].length);
+  EXPECT_EQ(0, corrections[syllable_id_["ju"]].distance);
+  EXPECT_EQ(0, corrections[syllable_id_["j"]].distance);
+  rime::corrector::Corrections fresh;
+  rime::NearSearchCorrector().ToleranceSearch(*prism_, "juw", &fresh, 1);
+  rime::corrector::Corrections resumed;
+  corrector_->ToleranceSearch(*prism_, "juw", &resumed, 1);
+  ASSERT_EQ(fresh.size(), resumed.size());
+  for (const auto& c : fresh) {
+    ASSERT_FALSE(resumed.end() == resumed.find(c.first));
+    EXPECT_EQ(c.second.distance, resumed[c.first].distance);
+  }
+}
+
+TEST_F(RimeCorrectorTest, CaseReloadedPrism) {
+  rime::corrector::Corrections corrections;
+  corrector_->ToleranceSearch(*prism_, "ju", &corrections, 1);
+  ASSERT_FALSE(corrections.end() == corrections.find(syllable_id_["ju"]));
+  // the same prism rebuilt for another dictionary
+  rime::set<rime::string> keyset{"ja", "ju", "shen"};
+  prism_->Build(keyset, nullptr, 1);
+  rime::corrector::Corrections rebuilt;
+  corrector_->ToleranceSearch(*prism_, "ju", &rebuilt, 1);
+  rime::corrector::Corrections fresh;
+  rime::NearSearchCorrector().ToleranceSearch(*prism_, "ju", &fresh, 1);
+  ASSERT_EQ(fresh.size(), rebuilt.size());
+  for (const auto& c : fresh) {
+    ASSERT_FALSE(rebuilt.end() == rebuilt.find(c.first));
+    EXPECT_EQ(c.second.distance, rebuilt[c.first].distance);
+  }
+  EXPECT_EQ(0, rebuilt[1].distance);  // ju
+}
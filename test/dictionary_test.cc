@@ -66,6 +66,52 @@ TEST_F(RimeDictionaryTest, PredictiveLookup) {
   EXPECT_EQ("za", raw_code.ToString());
 }
 
+TEST_F(RimeDictionaryTest, LookupByLengthClass) {
+  ASSERT_TRUE(dict_->loaded());
+  rime::DictEntryIterator all;
+  dict_->LookupWords(&all, "zhong", false);
+  size_t count = 0;
+  for (; !all.exhausted(); all.Next()) {
+    ++count;
+  }
+  rime::DictEntryIterator single_chars;
+  dict_->LookupWords(&single_chars, "zhong", false, 0, nullptr,
+                     rime::kSingleChar);
+  ASSERT_FALSE(single_chars.exhausted());
+  EXPECT_EQ("\xe4\xb8\xad", single_chars.Peek()->text);  // 中
+  size_t single_char_count = 0;
+  for (; !single_chars.exhausted(); single_chars.Next()) {
+    EXPECT_EQ(3, single_chars.Peek()->text.length());
+    ++single_char_count;
+  }
+  rime::DictEntryIterator multi_chars;
+  dict_->LookupWords(&multi_chars, "zhong", false, 0, nullptr,
+                     rime::kMultiChar);
+  size_t multi_char_count = 0;
+  for (; !multi_chars.exhausted(); multi_chars.Next()) {
+    EXPECT_LT(3, multi_chars.Peek()->text.length());
+    ++multi_char_count;
+  }
+  EXPECT_EQ(count, single_char_count + multi_char_count);
+}
+
+TEST_F(RimeDictionaryTest, SkipInLengthClass) {
+  ASSERT_TRUE(dict_->loaded());
+  rime::DictEntryIterator it;
+  dict_->LookupWords(&it, "zhong", false, 0, nullptr, rime::kSingleChar);
+  std::vector<std::string> texts;
+  for (; !it.exhausted(); it.Next()) {
+    texts.push_back(it.Peek()->text);
+  }
+  ASSERT_LT(1, texts.size());
+  rime::DictEntryIterator skipped;
+  dict_->LookupWords(&skipped, "zhong", false, 0, nullptr, rime::kSingleChar);
+  EXPECT_EQ(texts.size(), skipped.entry_count());
+  EXPECT_TRUE(skipped.Skip(1));
+  ASSERT_FALSE(skipped.exhausted());
+  EXPECT_EQ(texts[1], skipped.Peek()->text);
+}
+
 TEST_F(RimeDictionaryTest, ScriptLookup) {
   ASSERT_TRUE(dict_->loaded());
   rime::SyllableGraph g;
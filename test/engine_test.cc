@@ -0,0 +1,211 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <rime/candidate.h>
+#include <rime/component.h>
+#include <rime/config.h>
+#include <rime/context.h>
+#include <rime/engine.h>
+#include <rime/key_event.h>
+#include <rime/menu.h>
+#include <rime/registry.h>
+#include <rime/schema.h>
+#include <rime/translation.h>
+#include <rime/translator.h>
+#include <rime/dict/dict_compiler.h>
+#include <rime/dict/dictionary.h>
+
+using namespace rime;
+
+// holds queries of the slow translator until opened.
+class Gate {
+ public:
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_ = false;
+  }
+  void Open() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      open_ = true;
+    }
+    cv_.notify_all();
+  }
+  void Pass() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // a broken engine fails the test rather than hanging it
+    cv_.wait_for(lock, std::chrono::seconds(5), [this] { return open_; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool open_ = true;
+};
+
+static Gate gate;
+static std::atomic<int> slow_queries_done{0};
+
+// translates input into one candidate, "<name_space>:<input>".
+class TestTranslator : public Translator {
+ public:
+  explicit TestTranslator(const Ticket& ticket) : Translator(ticket) {
+    if (ticket.schema) {
+      ticket.schema->config()->GetDouble(name_space_ + "/initial_quality",
+                                         &quality_);
+    }
+  }
+
+  an<Translation> Query(const string& input, const Segment& segment) override {
+    if (name_space_ == "slow")
+      gate.Pass();
+    auto cand = New<SimpleCandidate>("test", segment.start, segment.end,
+                                     name_space_ + ":" + input);
+    cand->set_quality(quality_);
+    auto translation = New<FifoTranslation>();
+    translation->Append(cand);
+    if (name_space_ == "slow")
+      ++slow_queries_done;
+    return translation;
+  }
+  bool thread_safe() const override { return true; }
+
+ private:
+  double quality_ = 0;
+};
+
+class RimeEngineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Registry::instance().Register("test_translator",
+                                  new Component<TestTranslator>);
+    gate.Open();
+    slow_queries_done = 0;
+  }
+
+  void TearDown() override {
+    gate.Open();
+    engine_.reset();
+    Registry::instance().Unregister("test_translator");
+  }
+
+  void CreateEngine(int latency_budget) {
+    std::stringstream yaml;
+    yaml << "engine:\n"
+            "  segmentors: [abc_segmentor]\n"
+            "  translators: [test_translator@slow, test_translator@fast]\n"
+            "  filters: [uniquifier]\n"
+            "  concurrent_translators: [slow]\n"
+            "  translation_latency_budget: "
+         << latency_budget << "\n";
+    CreateEngine(yaml);
+  }
+
+  void CreateEngine(std::istream& yaml) {
+    Config* config = new Config;
+    ASSERT_TRUE(config->LoadFromStream(yaml));
+    engine_.reset(Engine::Create(new Schema("engine_test", config)));
+  }
+
+  vector<string> Candidates() {
+    vector<string> texts;
+    Context* ctx = engine_->context();
+    if (!ctx->HasMenu())
+      return texts;
+    auto menu = ctx->composition().back().menu;
+    for (size_t i = 0; i < 10; ++i) {
+      auto cand = menu->GetCandidateAt(i);
+      if (!cand)
+        break;
+      texts.push_back(cand->text());
+    }
+    return texts;
+  }
+
+  void WaitForSlowQueries(int count) {
+    for (int i = 0; i < 500 && slow_queries_done < count; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(count, slow_queries_done);
+  }
+
+  the<Engine> engine_;
+};
+
+TEST_F(RimeEngineTest, ConcurrentTranslationInTime) {
+  CreateEngine(5000);
+  engine_->context()->set_input("a");
+  // in the configured order
+  EXPECT_EQ((vector<string>{"slow:a", "fast:a"}), Candidates());
+}
+
+TEST_F(RimeEngineTest, LateTranslationIsMergedOnNextRefresh) {
+  CreateEngine(10);
+  gate.Close();
+  engine_->context()->set_input("a");
+  EXPECT_EQ((vector<string>{"fast:a"}), Candidates());
+  gate.Open();
+  WaitForSlowQueries(1);
+  // the query may still be returning
+  vector<string> candidates;
+  for (int i = 0; i < 500; ++i) {
+    // any key gives the engine a chance to refresh
+    engine_->ProcessKey(KeyEvent("Release+Shift_L"));
+    candidates = Candidates();
+    if (candidates.size() > 1)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  // candidates already obtained keep their places
+  EXPECT_EQ((vector<string>{"fast:a", "slow:a"}), candidates);
+}
+
+TEST_F(RimeEngineTest, LateTranslationOfReplacedInputIsDropped) {
+  CreateEngine(10);
+  gate.Close();
+  engine_->context()->set_input("a");
+  EXPECT_EQ((vector<string>{"fast:a"}), Candidates());
+  // the slow translator is still busy with "a"
+  engine_->context()->set_input("ab");
+  EXPECT_EQ((vector<string>{"fast:ab"}), Candidates());
+  gate.Open();
+  WaitForSlowQueries(1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  engine_->ProcessKey(KeyEvent("Release+Shift_L"));
+  EXPECT_EQ((vector<string>{"fast:ab"}), Candidates());
+}
+
+TEST_F(RimeEngineTest, SingleCharFilterWithSecondTranslator) {
+  Dictionary dict("single_char_test", {},
+                  {New<Table>(path{"single_char_test.table.bin"})},
+                  New<Prism>(path{"single_char_test.prism.bin"}));
+  DictCompiler dict_compiler(&dict);
+  ASSERT_TRUE(dict_compiler.Compile(path()));
+  std::stringstream yaml(
+      "engine:\n"
+      "  segmentors: [abc_segmentor]\n"
+      "  translators: [table_translator, test_translator@other]\n"
+      "  filters: [single_char_filter]\n"
+      "translator:\n"
+      "  dictionary: single_char_test\n"
+      "  enable_user_dict: false\n"
+      "  enable_completion: false\n"
+      "  enable_sentence: false\n"
+      "other:\n"
+      "  initial_quality: 1000\n");
+  CreateEngine(yaml);
+  engine_->context()->set_input("hao");
+  // the table translator looks up single characters first by itself; the
+  // filter leaves candidates of the other translator where they are.
+  EXPECT_EQ((vector<string>{"other:hao", "\xe5\xa5\xbd", "\xe5\x8f\xb7",
+                            "\xe5\xa5\xbd\xe4\xba\xba"}),
+            Candidates());  // 好, 号, 好人
+}
@@ -0,0 +1,74 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+#include <rime/config.h>
+#include <rime/dict/level_db.h>
+
+using namespace rime;
+
+TEST(RimeLevelDbOptionsTest, Defaults) {
+  LevelDbOptions options;
+  options.Load(nullptr, "userdb");
+  EXPECT_FALSE(options.configured);
+  EXPECT_EQ(8 << 20, options.block_cache_size);
+  EXPECT_EQ(0, options.write_buffer_size);
+  EXPECT_EQ(10, options.bloom_filter_bits);
+  EXPECT_TRUE(options.compression);
+  EXPECT_FALSE(options.fill_cache);
+  EXPECT_TRUE(bool(options.block_cache));
+  EXPECT_TRUE(bool(options.filter_policy));
+}
+
+TEST(RimeLevelDbOptionsTest, LoadFromConfig) {
+  std::stringstream yaml(
+      "userdb:\n"
+      "  block_cache_size: 0\n"
+      "  write_buffer_size: 1048576\n"
+      "  bloom_filter_bits: 0\n"
+      "  compression: false\n"
+      "  fill_cache: true\n"
+      "other_db:\n"
+      "  block_cache_size: 1024\n");
+  Config config;
+  ASSERT_TRUE(config.LoadFromStream(yaml));
+  LevelDbOptions options;
+  options.Load(&config, "userdb");
+  EXPECT_TRUE(options.configured);
+  EXPECT_EQ(0, options.block_cache_size);
+  EXPECT_EQ(1048576, options.write_buffer_size);
+  EXPECT_EQ(0, options.bloom_filter_bits);
+  EXPECT_FALSE(options.compression);
+  EXPECT_TRUE(options.fill_cache);
+  EXPECT_FALSE(bool(options.block_cache));
+  EXPECT_FALSE(bool(options.filter_policy));
+  // options of another db type are left alone
+  LevelDbOptions defaults;
+  defaults.Load(&config, "unconfigured_db");
+  EXPECT_EQ(8 << 20, defaults.block_cache_size);
+  EXPECT_EQ(10, defaults.bloom_filter_bits);
+}
+
+TEST(RimeLevelDbOptionsTest, ReadOnceGiven) {
+  // options are kept for the process; a fresh db type for each run.
+  static int run = 0;
+  const string db_type = "level_db_test" + std::to_string(++run);
+  std::stringstream yaml(db_type + ":\n  write_buffer_size: 65536\n");
+  Config config;
+  ASSERT_TRUE(config.LoadFromStream(yaml));
+  // dbs opened before the options are read have the defaults
+  const auto& defaults = LevelDbOptions::ForDbType(db_type);
+  EXPECT_FALSE(defaults.configured);
+  EXPECT_EQ(&defaults, &LevelDbOptions::ForDbType(db_type));
+  const auto& configured = LevelDbOptions::ForDbType(db_type, &config);
+  EXPECT_TRUE(configured.configured);
+  EXPECT_EQ(65536, configured.write_buffer_size);
+  EXPECT_EQ(0, defaults.write_buffer_size);
+  // and are not read again
+  Config empty;
+  EXPECT_EQ(&configured, &LevelDbOptions::ForDbType(db_type, &empty));
+  EXPECT_EQ(&configured, &LevelDbOptions::ForDbType(db_type));
+}
@@ -0,0 +1,66 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <rime/dict/mapped_file.h>
+
+using namespace rime;
+
+class TestFile : public MappedFile {
+ public:
+  explicit TestFile(const path& file_path) : MappedFile(file_path) {}
+
+  bool Build(size_t capacity, size_t count) {
+    if (!Create(capacity))
+      return false;
+    auto array = CreateArray<uint32_t>(count);
+    if (!array)
+      return false;
+    for (size_t i = 0; i < count; ++i) {
+      array->at[i] = static_cast<uint32_t>(i);
+    }
+    return true;
+  }
+  bool Save() { return ShrinkToFit(); }
+  bool Load() { return OpenReadOnly(); }
+};
+
+TEST(RimeMappedFileTest, BuildInMemory) {
+  path file_path("mapped_file_test.bin");
+  path temp_path("mapped_file_test.bin.tmp");
+  TestFile file(file_path);
+  file.Remove();
+  // grows well beyond the initial capacity
+  ASSERT_TRUE(file.Build(16, 1000));
+  EXPECT_FALSE(file.Exists());
+  ASSERT_TRUE(file.Save());
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_FALSE(std::filesystem::exists(temp_path));
+  ASSERT_TRUE(file.Load());
+  EXPECT_EQ(sizeof(uint32_t) * 1001, file.file_size());
+  auto array = file.Find<Array<uint32_t>>(0);
+  ASSERT_TRUE(array != nullptr);
+  ASSERT_EQ(1000, array->size);
+  EXPECT_EQ(0, array->at[0]);
+  EXPECT_EQ(999, array->at[999]);
+  file.Close();
+  file.Remove();
+}
+
+TEST(RimeMappedFileTest, AbortedBuildKeepsFile) {
+  path file_path("mapped_file_test.bin");
+  TestFile file(file_path);
+  file.Remove();
+  ASSERT_TRUE(file.Build(64, 3));
+  ASSERT_TRUE(file.Save());
+  ASSERT_TRUE(file.Build(64, 5));
+  file.Close();
+  ASSERT_TRUE(file.Load());
+  auto array = file.Find<Array<uint32_t>>(0);
+  ASSERT_TRUE(array != nullptr);
+  EXPECT_EQ(3, array->size);
+  file.Close();
+  file.Remove();
+}
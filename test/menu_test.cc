@@ -77,3 +77,37 @@ TEST(RimeMenuTest, RecipeAlphaBeta) {
   the<Page> no_more_page(menu.CreatePage(5, 1));
   EXPECT_FALSE(bool(no_more_page));
 }
+
+TEST(RimeMenuTest, Prefetch) {
+  Menu menu;
+  menu.AddTranslation(New<TranslationAlpha>());
+  menu.AddTranslation(New<TranslationBeta>());
+  menu.Prefetch(3);
+  the<Page> page(menu.CreatePage(2, 1));
+  ASSERT_TRUE(bool(page));
+  ASSERT_EQ(2, page->candidates.size());
+  EXPECT_EQ("Beta-2", page->candidates[0]->text());
+  EXPECT_EQ("Beta-3", page->candidates[1]->text());
+  EXPECT_TRUE(page->is_last_page);
+  EXPECT_EQ(4, menu.candidate_count());
+}
+
+TEST(RimeMenuTest, DisposeWhilePrefetching) {
+  auto menu = New<Menu>();
+  menu->AddTranslation(New<TranslationBeta>());
+  menu->Prefetch(100);
+  menu.reset();
+}
+
+TEST(RimeMenuTest, CancelPrefetch) {
+  Menu menu;
+  menu.AddTranslation(New<TranslationBeta>());
+  menu.Prefetch(100);
+  menu.CancelPrefetch();
+  // can be started over
+  menu.Prefetch(100);
+  the<Page> page(menu.CreatePage(5, 0));
+  ASSERT_TRUE(bool(page));
+  EXPECT_EQ(3, page->candidates.size());
+  EXPECT_TRUE(page->is_last_page);
+}
@@ -75,6 +75,27 @@ TEST_F(RimePrismTest, CommonPrefixMatch) {
   EXPECT_EQ(result[1].length, 7);  // goodbye
 }
 
+TEST_F(RimePrismTest, CommonPrefixMatchAll) {
+  const string input = "yahoogoodbye";
+  Prism::MatchTable table;
+  prism_->CommonPrefixSearchAll(input, &table);
+  // positions are searched in any order, as they are visited
+  for (size_t pos = input.length(); pos-- > 0;) {
+    vector<Prism::Match> expected;
+    prism_->CommonPrefixSearch(input.substr(pos), &expected);
+    ASSERT_EQ(expected.size(), table.end(pos) - table.begin(pos));
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i].value, table.begin(pos)[i].value);
+      EXPECT_EQ(expected[i].length, table.begin(pos)[i].length);
+    }
+  }
+  // yahoo at 0; good and goodbye at 5.
+  EXPECT_EQ(1, table.end(0) - table.begin(0));
+  EXPECT_EQ(2, table.end(5) - table.begin(5));
+  EXPECT_EQ(table.begin(1), table.end(1));
+  EXPECT_EQ(table.begin(input.length()), table.end(input.length()));
+}
+
 TEST_F(RimePrismTest, ExpandSearch) {
   vector<Prism::Match> result;
 
@@ -88,3 +109,49 @@ TEST_F(RimePrismTest, ExpandSearch) {
   EXPECT_EQ(result[2].value, 3);   // goodbye
   EXPECT_EQ(result[2].length, 7);  // goodbye
 }
+
+TEST_F(RimePrismTest, TopKExpandSearch) {
+  set<string> keyset{"adobe",  "baidu",     "good",      "goodbye",
+                     "google", "macrosoft", "microsoft", "yahoo"};
+  vector<prism::Weight> weights{0.0, 0.0, 1.0, 5.0, 3.0, 0.0, 2.0, 0.0};
+  Prism prism(path{"prism_test.bin"});
+  prism.Remove();
+  ASSERT_TRUE(prism.Build(keyset, nullptr, 0, 0, &weights));
+  ASSERT_TRUE(prism.has_completion_index());
+  ASSERT_TRUE(prism.Save());
+
+  Prism loaded(prism.file_path());
+  ASSERT_TRUE(loaded.Load());
+  ASSERT_TRUE(loaded.has_completion_index());
+
+  vector<Prism::Match> result;
+  loaded.TopKExpandSearch("goo", &result, 10);
+  // best first: goodbye, google, good.
+  ASSERT_EQ(result.size(), 3);
+  EXPECT_EQ(result[0].value, 3);   // goodbye
+  EXPECT_EQ(result[0].length, 7);  // goodbye
+  EXPECT_EQ(result[1].value, 4);   // google
+  EXPECT_EQ(result[2].value, 2);   // good
+
+  loaded.TopKExpandSearch("goo", &result, 2);
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_EQ(result[0].value, 3);  // goodbye
+  EXPECT_EQ(result[1].value, 4);  // google
+
+  // an exact match still comes first
+  loaded.TopKExpandSearch("good", &result, 1);
+  ASSERT_EQ(result.size(), 1);
+  EXPECT_EQ(result[0].value, 2);  // good
+
+  loaded.TopKExpandSearch("m", &result, 0);
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_EQ(result[0].value, 6);  // microsoft
+  EXPECT_EQ(result[1].value, 5);  // macrosoft
+
+  // plain expand search keeps the shortest keys first
+  loaded.ExpandSearch("goo", &result, 10);
+  ASSERT_EQ(result.size(), 3);
+  EXPECT_EQ(result[0].value, 2);  // good
+  EXPECT_EQ(result[1].value, 4);  // google
+  EXPECT_EQ(result[2].value, 3);  // goodbye
+}
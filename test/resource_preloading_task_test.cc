@@ -0,0 +1,96 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <gtest/gtest.h>
+#include <rime/deployer.h>
+#include <rime/schema.h>
+#include <rime/service.h>
+#include <rime/ticket.h>
+#include <rime/dict/dict_compiler.h>
+#include <rime/dict/dictionary.h>
+#include <rime/dict/prism.h>
+#include <rime/dict/table.h>
+#include <rime/dict/user_dictionary.h>
+
+using namespace rime;
+
+class RimeResourcePreloadingTaskTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Dictionary dict("single_char_test", {},
+                    {New<Table>(path{"single_char_test.table.bin"})},
+                    New<Prism>(path{"single_char_test.prism.bin"}));
+    DictCompiler dict_compiler(&dict);
+    ASSERT_TRUE(dict_compiler.Compile(path()));
+    schema_.reset(new Schema("preload_test"));
+    ASSERT_TRUE(schema_->config() != nullptr);
+  }
+
+  void TearDown() override { RunTask("pin_resources", {}); }
+
+  bool RunTask(const string& task_name, const vector<string>& schema_ids) {
+    return Service::instance().deployer().RunTask(task_name, schema_ids);
+  }
+
+  // what a later session creates for the schema
+  an<Dictionary> CreateDictionary() {
+    Ticket ticket(schema_.get(), "translator");
+    return an<Dictionary>(Dictionary::Require("dictionary")->Create(ticket));
+  }
+
+  an<UserDictionary> CreateUserDictionary() {
+    Ticket ticket(schema_.get(), "translator");
+    return an<UserDictionary>(
+        UserDictionary::Require("user_dictionary")->Create(ticket));
+  }
+
+  the<Schema> schema_;
+};
+
+TEST_F(RimeResourcePreloadingTaskTest, PreloadReleasesResources) {
+  ASSERT_TRUE(RunTask("preload_resources", {"preload_test"}));
+  auto dictionary = CreateDictionary();
+  ASSERT_TRUE(bool(dictionary));
+  EXPECT_FALSE(dictionary->loaded());
+  auto user_dictionary = CreateUserDictionary();
+  ASSERT_TRUE(bool(user_dictionary));
+  EXPECT_FALSE(user_dictionary->loaded());
+}
+
+TEST_F(RimeResourcePreloadingTaskTest, PinnedResourcesAreShared) {
+  ASSERT_TRUE(RunTask("pin_resources", {"preload_test"}));
+  weak<Prism> prism;
+  {
+    auto dictionary = CreateDictionary();
+    ASSERT_TRUE(bool(dictionary));
+    EXPECT_TRUE(dictionary->loaded());
+    prism = dictionary->prism();
+    auto user_dictionary = CreateUserDictionary();
+    ASSERT_TRUE(bool(user_dictionary));
+    EXPECT_TRUE(user_dictionary->loaded());
+  }
+  // the session has ended; another one shares the pinned resources.
+  auto dictionary = CreateDictionary();
+  ASSERT_TRUE(bool(dictionary));
+  EXPECT_EQ(prism.lock(), dictionary->prism());
+  EXPECT_TRUE(dictionary->loaded());
+  auto user_dictionary = CreateUserDictionary();
+  ASSERT_TRUE(bool(user_dictionary));
+  EXPECT_TRUE(user_dictionary->loaded());
+}
+
+TEST_F(RimeResourcePreloadingTaskTest, EmptyPinListReleasesResources) {
+  ASSERT_TRUE(RunTask("pin_resources", {"preload_test"}));
+  weak<Prism> prism = CreateDictionary()->prism();
+  EXPECT_FALSE(prism.expired());
+
+  ASSERT_TRUE(RunTask("pin_resources", {}));
+  EXPECT_TRUE(prism.expired());
+  auto dictionary = CreateDictionary();
+  ASSERT_TRUE(bool(dictionary));
+  EXPECT_FALSE(dictionary->loaded());
+  auto user_dictionary = CreateUserDictionary();
+  ASSERT_TRUE(bool(user_dictionary));
+  EXPECT_FALSE(user_dictionary->loaded());
+}
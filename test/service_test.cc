@@ -0,0 +1,101 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <gtest/gtest.h>
+#include <rime_api.h>
+#include <rime/commit_history.h>
+#include <rime/config.h>
+#include <rime/context.h>
+#include <rime/key_table.h>
+#include <rime/service.h>
+
+using namespace rime;
+
+class RimeServiceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    rime_ = rime_get_api();
+    session_id_ = rime_->create_session();
+    ASSERT_NE(0, session_id_);
+  }
+
+  void TearDown() override { rime_->destroy_session(session_id_); }
+
+  bool Hibernated() {
+    auto session = Service::instance().PeekSession(session_id_);
+    return session && session->hibernated();
+  }
+
+  RimeApi* rime_ = nullptr;
+  RimeSessionId session_id_ = 0;
+};
+
+TEST_F(RimeServiceTest, WakeRestoresSessionState) {
+  rime_->set_input(session_id_, "hello");
+  ASSERT_TRUE(rime_->commit_composition(session_id_));
+  rime_->set_input(session_id_, "world");
+  rime_->set_caret_pos(session_id_, 2);
+  rime_->set_option(session_id_, "ascii_mode", True);
+
+  // idle for any time at all.
+  EXPECT_LE(1, Service::instance().HibernateIdleSessions(-1));
+  ASSERT_TRUE(Hibernated());
+
+  RIME_STRUCT(RimeContext, ctx);
+  ASSERT_TRUE(rime_->get_context(session_id_, &ctx));
+  EXPECT_FALSE(Hibernated());
+  ASSERT_TRUE(ctx.composition.preedit != nullptr);
+  EXPECT_STREQ("world", rime_->get_input(session_id_));
+  EXPECT_EQ(2, rime_->get_caret_pos(session_id_));
+  EXPECT_TRUE(Bool(rime_->get_option(session_id_, "ascii_mode")));
+  rime_->free_context(&ctx);
+
+  auto session = Service::instance().PeekSession(session_id_);
+  ASSERT_TRUE(bool(session));
+  auto* context = session->context();
+  ASSERT_TRUE(context != nullptr);
+  EXPECT_EQ("hello", context->commit_history().latest_text());
+}
+
+TEST_F(RimeServiceTest, FindSessionAndGetCommitDoNotWake) {
+  rime_->set_input(session_id_, "hello");
+  ASSERT_TRUE(rime_->commit_composition(session_id_));
+  EXPECT_LE(1, Service::instance().HibernateIdleSessions(-1));
+  ASSERT_TRUE(Hibernated());
+
+  EXPECT_TRUE(Bool(rime_->find_session(session_id_)));
+  EXPECT_TRUE(Hibernated());
+
+  // the commit text outlives the engine.
+  RIME_STRUCT(RimeCommit, commit);
+  ASSERT_TRUE(rime_->get_commit(session_id_, &commit));
+  EXPECT_STREQ("hello", commit.text);
+  rime_->free_commit(&commit);
+  EXPECT_TRUE(Hibernated());
+}
+
+TEST_F(RimeServiceTest, SessionWithSwitcherOpenIsNotHibernated) {
+  rime_->destroy_session(session_id_);
+  // the switcher reads its hotkeys from the shared default config.
+  the<Config> config(Config::Require("config")->Create("default"));
+  ASSERT_TRUE(bool(config));
+  ASSERT_TRUE(config->SetString("switcher/hotkeys/@next", "F4"));
+  session_id_ = rime_->create_session();
+  ASSERT_NE(0, session_id_);
+  RimeSessionId other_session_id = rime_->create_session();
+  ASSERT_NE(0, other_session_id);
+
+  ASSERT_TRUE(rime_->process_key(session_id_, XK_F4, 0));
+
+  size_t hibernated = Service::instance().HibernateIdleSessions(-1);
+  EXPECT_FALSE(Hibernated());
+  auto other_session = Service::instance().PeekSession(other_session_id);
+  ASSERT_TRUE(bool(other_session));
+  EXPECT_TRUE(other_session->hibernated());
+  // sessions left idle by other tests may be hibernated, too.
+  EXPECT_LE(1, hibernated);
+
+  rime_->destroy_session(other_session_id);
+  config->SetItem("switcher", nullptr);
+}
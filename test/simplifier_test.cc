@@ -0,0 +1,88 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <rime/gear/simplifier.h>
+
+using namespace rime;
+
+class RimeOpenccTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    {
+      std::ofstream out(dict_path_.c_str());
+      out << "漢\t汉\n"
+             "漢字\t汉字\n"
+             "乾\t干 乾\n";
+    }
+    std::ofstream out(config_path_.c_str());
+    out << "{\n"
+           "  \"name\": \"opencc_test\",\n"
+           "  \"segmentation\": {\n"
+           "    \"type\": \"mmseg\",\n"
+           "    \"dict\": {\"type\": \"text\", \"file\": \"opencc_test.txt\"}\n"
+           "  },\n"
+           "  \"conversion_chain\": [{\n"
+           "    \"dict\": {\"type\": \"text\", \"file\": \"opencc_test.txt\"}\n"
+           "  }]\n"
+           "}\n";
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(config_path_);
+    std::filesystem::remove(dict_path_);
+  }
+
+  path config_path_{"opencc_test.json"};
+  path dict_path_{"opencc_test.txt"};
+};
+
+TEST_F(RimeOpenccTest, CachedWordConversion) {
+  Opencc opencc(config_path_);
+  for (const string word : {"漢字", "乾"}) {
+    vector<string> uncached;
+    ASSERT_TRUE(Opencc(config_path_).ConvertWord(word, &uncached));
+    vector<string> first;
+    ASSERT_TRUE(opencc.ConvertWord(word, &first));
+    vector<string> cached;
+    ASSERT_TRUE(opencc.ConvertWord(word, &cached));
+    EXPECT_EQ(uncached, first);
+    EXPECT_EQ(uncached, cached);
+  }
+  EXPECT_EQ(2, opencc.cached_words());
+  vector<string> forms;
+  ASSERT_TRUE(opencc.ConvertWord("乾", &forms));
+  EXPECT_EQ((vector<string>{"干", "乾"}), forms);
+}
+
+TEST_F(RimeOpenccTest, FailedWordConversionIsCached) {
+  Opencc opencc(config_path_);
+  vector<string> forms{"untouched"};
+  EXPECT_FALSE(opencc.ConvertWord("rime", &forms));
+  EXPECT_EQ(1, opencc.cached_words());
+  EXPECT_FALSE(opencc.ConvertWord("rime", &forms));
+  EXPECT_EQ(1, opencc.cached_words());
+  EXPECT_EQ((vector<string>{"untouched"}), forms);
+}
+
+TEST_F(RimeOpenccTest, CachedTextConversion) {
+  Opencc opencc(config_path_);
+  string uncached;
+  ASSERT_TRUE(Opencc(config_path_).ConvertText("漢字乾", &uncached));
+  string first;
+  ASSERT_TRUE(opencc.ConvertText("漢字乾", &first));
+  string cached;
+  ASSERT_TRUE(opencc.ConvertText("漢字乾", &cached));
+  EXPECT_EQ(uncached, first);
+  EXPECT_EQ(uncached, cached);
+  EXPECT_EQ("汉字干", cached);
+  // text left as is is cached, too
+  string same;
+  EXPECT_FALSE(opencc.ConvertText("rime", &same));
+  EXPECT_FALSE(opencc.ConvertText("rime", &same));
+  EXPECT_EQ("rime", same);
+  EXPECT_EQ(2, opencc.cached_texts());
+}
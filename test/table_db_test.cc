@@ -0,0 +1,53 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <rime/dict/table_db.h>
+
+using namespace rime;
+
+static void write_phrases(const path& file_path, const string& content) {
+  std::ofstream out(file_path.c_str());
+  out << content;
+}
+
+TEST(RimeStableDbTest, CompileAndQuery) {
+  path file_path{"stable_db_test.txt"};
+  write_phrases(file_path,
+                "\xe4\xbd\xa0\xe5\xa5\xbd\tnihao\t2\n"  // 你好
+                "\xe4\xbd\xa0\tni\t1\n"                 // 你
+                "\xe5\xa5\xbd\thao\n");                 // 好
+  StableDb db(file_path, "stable_db_test");
+  std::filesystem::remove(db.image_path());
+  ASSERT_TRUE(db.Open());
+  EXPECT_TRUE(db.readonly());
+  EXPECT_TRUE(std::filesystem::exists(db.image_path()));
+  string value;
+  EXPECT_TRUE(db.Fetch("ni \t\xe4\xbd\xa0", &value));
+  EXPECT_FALSE(db.Fetch("ni", &value));
+  {
+    auto accessor = db.Query("ni");
+    ASSERT_TRUE(bool(accessor));
+    string key;
+    EXPECT_TRUE(accessor->GetNextRecord(&key, &value));
+    EXPECT_EQ("ni \t\xe4\xbd\xa0", key);
+    EXPECT_TRUE(accessor->GetNextRecord(&key, &value));
+    EXPECT_EQ("nihao \t\xe4\xbd\xa0\xe5\xa5\xbd", key);
+    EXPECT_TRUE(accessor->exhausted());
+  }
+  EXPECT_FALSE(db.Update("hao \t\xe5\xa5\xbd", value));
+  EXPECT_TRUE(db.Close());
+
+  // the text file has changed; the image is rebuilt.
+  write_phrases(file_path, "\xe5\xa5\xbd\thao\n");
+  ASSERT_TRUE(db.Open());
+  EXPECT_FALSE(db.Fetch("ni \t\xe4\xbd\xa0", &value));
+  EXPECT_TRUE(db.Fetch("hao \t\xe5\xa5\xbd", &value));
+  EXPECT_TRUE(db.Close());
+
+  std::filesystem::remove(db.image_path());
+  std::filesystem::remove(file_path);
+}
@@ -4,6 +4,7 @@
 //
 // 2011-07-03 GONG Chen <chen.sst@gmail.com>
 //
+#include <cmath>
 #include <gtest/gtest.h>
 #include <rime/algo/syllabifier.h>
 #include <rime/dict/table.h>
@@ -107,7 +108,7 @@ TEST_F(RimeTableTest, SimpleQuery) {
   ASSERT_EQ(1, v.remaining());
   ASSERT_TRUE(v.entry() != NULL);
   EXPECT_STREQ("yi", Text(v).c_str());
-  EXPECT_EQ(1.0, v.entry()->weight);
+  EXPECT_EQ(1.0, v.entry()->weight());
   EXPECT_FALSE(v.Next());
 
   v = table_->QueryWords(2);
@@ -203,3 +204,22 @@ TEST_F(RimeTableTest, QueryWithSyllableGraph) {
   EXPECT_STREQ("lia", Text(result[4].front()).c_str());
   EXPECT_FALSE(result[4].front().Next());
 }
+
+TEST(RimeTableEntryTest, CompactEntry) {
+  EXPECT_EQ(6, sizeof(rime::table::Entry));
+  rime::table::Entry e{};
+  e.set_text_id(0x12345678);
+  EXPECT_EQ(0x12345678, e.text_id());
+  EXPECT_FALSE(e.single_char());
+  e.set_single_char(true);
+  EXPECT_TRUE(e.single_char());
+  EXPECT_EQ(0x12345678, e.text_id());
+  e.set_text_id(0x7654321);
+  EXPECT_TRUE(e.single_char());
+  EXPECT_EQ(0x7654321, e.text_id());
+  e.set_weight(std::log(100.0));
+  EXPECT_NEAR(std::log(100.0), e.weight(), 0.5 / rime::table::kWeightScale);
+  e.set_weight(-1e3);
+  EXPECT_GT(-31.0, e.weight());
+  EXPECT_LT(-33.0, e.weight());
+}
@@ -0,0 +1,95 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <gtest/gtest.h>
+#include <rime/candidate.h>
+#include <rime/filter.h>
+#include <rime/menu.h>
+#include <rime/ticket.h>
+#include <rime/tracer.h>
+#include <rime/translation.h>
+
+using namespace rime;
+
+class PassThroughFilter : public Filter {
+ public:
+  explicit PassThroughFilter(const Ticket& ticket) : Filter(ticket) {}
+  an<Translation> Apply(an<Translation> translation,
+                        CandidateList* candidates) {
+    return translation;
+  }
+};
+
+TEST(RimeTracerTest, NestedStages) {
+  Tracer tracer;
+  tracer.set_enabled(true);
+  {
+    TraceScope outer(&tracer, "outer");
+    for (int i = 0; i < 3; ++i) {
+      TraceScope inner(&tracer, "inner");
+    }
+  }
+  const auto& stats = tracer.stats();
+  ASSERT_EQ(2, stats.size());
+  const auto& outer = stats.at("outer");
+  const auto& inner = stats.at("inner");
+  EXPECT_EQ(1, outer.count);
+  EXPECT_EQ(3, inner.count);
+  EXPECT_EQ(inner.total_ns, inner.self_ns);
+  EXPECT_EQ(outer.total_ns - inner.total_ns, outer.self_ns);
+  EXPECT_LE(inner.max_ns, inner.total_ns);
+  tracer.Reset();
+  EXPECT_TRUE(tracer.stats().empty());
+}
+
+TEST(RimeTracerTest, Disabled) {
+  Tracer tracer;
+  {
+    TraceScope scope(&tracer, "stage");
+  }
+  EXPECT_TRUE(tracer.stats().empty());
+}
+
+TEST(RimeTracerTest, TracedMenu) {
+  auto tracer = New<Tracer>();
+  tracer->set_enabled(true);
+  auto fifo = New<FifoTranslation>();
+  fifo->Append(New<SimpleCandidate>("abc", 0, 3, "ABC"));
+  fifo->Append(New<SimpleCandidate>("abc", 0, 3, "abc"));
+  Ticket ticket;
+  ticket.name_space = "pass";
+  PassThroughFilter filter(ticket);
+  Menu menu;
+  menu.set_tracer(tracer);
+  menu.AddTranslation(New<TracedTranslation>(fifo, tracer, "translation"));
+  menu.AddFilter(&filter);
+  EXPECT_EQ(2, menu.Prepare(5));
+  EXPECT_FALSE(menu.empty());
+  const auto& stats = tracer->stats();
+  EXPECT_EQ(1, stats.at("menu/prepare").count);
+  EXPECT_EQ(1, stats.at("filter/pass").count);
+  EXPECT_LT(0, stats.at("filter/pass/candidates").count);
+  EXPECT_LT(0, stats.at("translation").count);
+}
+
+TEST(RimeTracerTest, DumpTrace) {
+  Tracer tracer;
+  tracer.set_enabled(true);
+  {
+    TraceScope scope(&tracer, "process_key");
+  }
+  path file_path("tracer_test.json");
+  ASSERT_TRUE(tracer.DumpTrace(file_path));
+  std::ifstream fin(file_path.c_str());
+  string content((std::istreambuf_iterator<char>(fin)),
+                 std::istreambuf_iterator<char>());
+  fin.close();
+  std::filesystem::remove(file_path);
+  EXPECT_NE(string::npos, content.find("\"traceEvents\""));
+  EXPECT_NE(string::npos, content.find("\"name\":\"process_key\""));
+  EXPECT_NE(string::npos, content.find("\"ph\":\"X\""));
+}
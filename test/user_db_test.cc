@@ -4,10 +4,15 @@
 //
 // 2011-07-03 GONG Chen <chen.sst@gmail.com>
 //
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <gtest/gtest.h>
 #include <rime/algo/syllabifier.h>
 #include <rime/dict/text_db.h>
 #include <rime/dict/user_db.h>
+#include <rime/dict/user_db_delta.h>
+#include <rime/dict/user_dictionary.h>
 
 using namespace rime;
 
@@ -89,3 +94,262 @@ TEST(RimeUserDbTest, Query) {
   }
   db.Close();
 }
+
+static string make_value(int commits, double dee, TickCount tick) {
+  UserDbValue v;
+  v.commits = commits;
+  v.dee = dee;
+  v.tick = tick;
+  return v.Pack();
+}
+
+TEST(RimeUserDbTest, DeltaSnapshot) {
+  TestDb db(path{"user_db_test.txt"}, "user_db_test");
+  if (db.Exists())
+    db.Remove();
+  ASSERT_FALSE(db.Exists());
+  db.Open();
+  EXPECT_TRUE(db.MetaUpdate("/tick", "3"));
+  EXPECT_TRUE(db.Update("ni \t你", make_value(1, 0.5, 1)));
+  EXPECT_TRUE(db.Update("ni hao \t你好", make_value(2, 1.5, 2)));
+  EXPECT_TRUE(db.Update("ni hao \t擬好", make_value(-1, 0.25, 3)));
+  path delta_file{"user_db_test.delta"};
+  {
+    UserDbDeltaWriter writer(delta_file, 2);
+    DbSource source(&db);
+    EXPECT_EQ(2, writer << source);
+  }
+  db.Close();
+
+  UserDbDeltaReader reader(delta_file);
+  UserDbDeltaHeader header;
+  ASSERT_TRUE(reader.ReadHeader(&header));
+  EXPECT_EQ(2u, header.since_tick);
+  EXPECT_EQ(3u, header.tick);
+
+  TestDb copy(path{"user_db_test_copy.txt"}, "user_db_test_copy");
+  if (copy.Exists())
+    copy.Remove();
+  copy.Open();
+  DbSink sink(&copy);
+  EXPECT_EQ(2, reader >> sink);
+  string value;
+  EXPECT_TRUE(copy.MetaFetch("/tick", &value));
+  EXPECT_EQ("3", value);
+  EXPECT_FALSE(copy.Fetch("ni \t你", &value));
+  ASSERT_TRUE(copy.Fetch("ni hao \t你好", &value));
+  UserDbValue v(value);
+  EXPECT_EQ(2, v.commits);
+  EXPECT_DOUBLE_EQ(1.5, v.dee);
+  EXPECT_EQ(2u, v.tick);
+  ASSERT_TRUE(copy.Fetch("ni hao \t擬好", &value));
+  EXPECT_EQ(-1, UserDbValue(value).commits);
+  copy.Close();
+}
+
+TEST(RimeUserDbTest, DeltaSnapshotExcludesMergedEntries) {
+  TestDb db(path{"user_db_test.txt"}, "user_db_test");
+  if (db.Exists())
+    db.Remove();
+  db.Open();
+  EXPECT_TRUE(db.MetaUpdate("/tick", "9"));
+  // merged in an earlier sync
+  EXPECT_TRUE(db.Update("0 \t0", make_value(1, 1.0, 2)));
+  EXPECT_TRUE(db.Update("a \tA", make_value(1, 1.0, 3)));
+  // merged from other devices
+  EXPECT_TRUE(db.Update("b \tB", make_value(1, 1.0, 9)));
+  EXPECT_TRUE(db.Update("c \tC", make_value(1, 1.0, 9)));
+  // also updated here before merging
+  EXPECT_TRUE(db.Update("d \tD", make_value(1, 1.0, 9)));
+  path delta_file{"user_db_test.delta"};
+  {
+    UserDbDeltaWriter writer(delta_file, 1);
+    set<string> merged_keys{"b \tB", "c \tC"};
+    writer.Exclude(2, &merged_keys);
+    DbSource source(&db);
+    EXPECT_EQ(2, writer << source);
+  }
+  db.Close();
+
+  TestDb copy(path{"user_db_test_copy.txt"}, "user_db_test_copy");
+  if (copy.Exists())
+    copy.Remove();
+  copy.Open();
+  UserDbDeltaReader reader(delta_file);
+  DbSink sink(&copy);
+  EXPECT_EQ(2, reader >> sink);
+  string value;
+  EXPECT_FALSE(copy.Fetch("0 \t0", &value));
+  EXPECT_TRUE(copy.Fetch("a \tA", &value));
+  EXPECT_FALSE(copy.Fetch("b \tB", &value));
+  EXPECT_FALSE(copy.Fetch("c \tC", &value));
+  EXPECT_TRUE(copy.Fetch("d \tD", &value));
+  copy.Close();
+}
+
+TEST(RimeUserDbTest, ImportInKeyOrder) {
+  TestDb db(path{"user_db_test.txt"}, "user_db_test");
+  if (db.Exists())
+    db.Remove();
+  ASSERT_FALSE(db.Exists());
+  db.Open();
+  EXPECT_TRUE(db.Update("a \tA", make_value(1, 1.0, 1)));
+  EXPECT_TRUE(db.Update("c \tC", make_value(3, 1.0, 1)));
+  {
+    UserDbImporter importer(&db);
+    EXPECT_TRUE(importer.Put("a \tA", make_value(2, 1.0, 1)));
+    EXPECT_TRUE(importer.Put("b \tB", make_value(1, 1.0, 1)));
+    EXPECT_TRUE(importer.Put("c \tC", make_value(1, 1.0, 1)));
+    // out of order
+    EXPECT_TRUE(importer.Put("b \tB", make_value(5, 1.0, 1)));
+    EXPECT_TRUE(importer.Put("d \tD", make_value(1, 1.0, 1)));
+  }
+  string value;
+  ASSERT_TRUE(db.Fetch("a \tA", &value));
+  EXPECT_EQ(2, UserDbValue(value).commits);
+  ASSERT_TRUE(db.Fetch("b \tB", &value));
+  EXPECT_EQ(5, UserDbValue(value).commits);
+  ASSERT_TRUE(db.Fetch("c \tC", &value));
+  EXPECT_EQ(3, UserDbValue(value).commits);
+  ASSERT_TRUE(db.Fetch("d \tD", &value));
+  EXPECT_EQ(1, UserDbValue(value).commits);
+  db.Close();
+}
+
+TEST(RimeUserDbTest, SyllableIdKeys) {
+  TestDb db(path{"user_db_test.txt"}, "user_db_test");
+  if (db.Exists())
+    db.Remove();
+  db.Open();
+  EXPECT_TRUE(db.Update("ni hao \t你好", make_value(2, 1.0, 1)));
+  EXPECT_TRUE(db.Update("zai \t在", make_value(1, 1.0, 1)));
+  {
+    UserDbSyllabary syllabary(&db);
+    EXPECT_FALSE(syllabary.Load());
+    ASSERT_TRUE(syllabary.EncodeKeys({"hao", "ni", "wo"}));
+    // in alphabetical order
+    EXPECT_EQ("000", syllabary.GetId("hao"));
+    EXPECT_EQ("001", syllabary.GetId("ni"));
+    EXPECT_EQ("002", syllabary.GetId("wo"));
+    EXPECT_EQ("003", syllabary.GetId("zai"));
+    string value;
+    EXPECT_FALSE(db.Fetch("ni hao \t你好", &value));
+    ASSERT_TRUE(db.Fetch("001 000 \t你好", &value));
+    EXPECT_EQ(2, UserDbValue(value).commits);
+    EXPECT_TRUE(db.Fetch("003 \t在", &value));
+  }
+  {
+    // ids are saved, and new syllables do not change them
+    UserDbSyllabary syllabary(&db);
+    ASSERT_TRUE(syllabary.Load());
+    ASSERT_TRUE(syllabary.Add({"a", "ni"}));
+    EXPECT_EQ("004", syllabary.GetId("a"));
+    EXPECT_EQ("001", syllabary.GetId("ni"));
+    string key;
+    ASSERT_TRUE(syllabary.EncodeKey("a ni \t啊你", &key));
+    EXPECT_EQ("004 001 \t啊你", key);
+    EXPECT_FALSE(syllabary.EncodeKey("ta \t他", &key));
+    string spelled;
+    ASSERT_TRUE(syllabary.DecodeKey(key, &spelled));
+    EXPECT_EQ("a ni \t啊你", spelled);
+  }
+  {
+    // snapshots have spelled keys
+    UserDbSource source(&db);
+    string key, value;
+    while (source.MetaGet(&key, &value)) {
+      EXPECT_NE("/key_encoding", key);
+      EXPECT_NE("/syllables", key);
+    }
+    ASSERT_TRUE(source.Get(&key, &value));
+    EXPECT_EQ("ni hao \t你好", key);
+    ASSERT_TRUE(source.Get(&key, &value));
+    EXPECT_EQ("zai \t在", key);
+    EXPECT_FALSE(source.Get(&key, &value));
+  }
+  db.Close();
+}
+
+TEST(RimeUserDbTest, AsyncLearning) {
+  auto db = New<TestDb>(path{"user_db_test.txt"}, "user_db_test");
+  if (db->Exists())
+    db->Remove();
+  ASSERT_TRUE(db->Open());
+  {
+    UserDictionary user_dict("user_db_test", db);
+    ASSERT_TRUE(user_dict.Load());
+    user_dict.EnableAsyncLearning(New<std::mutex>());
+    DictEntry entry;
+    entry.custom_code = "abc ";
+    for (int i = 0; i < 100; ++i) {
+      entry.text = "ABC" + std::to_string(i % 10);
+      EXPECT_TRUE(user_dict.UpdateEntry(entry, 1));
+    }
+    // reads its own writes
+    UserDictEntryIterator result;
+    EXPECT_EQ(10, user_dict.LookupWords(&result, "abc", false));
+    EXPECT_EQ(100, user_dict.tick());
+    user_dict.WaitForLearning();
+    string value;
+    ASSERT_TRUE(db->Fetch("abc \tABC3", &value));
+    EXPECT_EQ(10, UserDbValue(value).commits);
+  }
+  db->Close();
+}
+
+// a db whose writes wait at the gate until the test lets them go.
+class GatedDb : public TestDb {
+ public:
+  explicit GatedDb(std::shared_future<void> gate)
+      : TestDb(path{"user_db_test.txt"}, "user_db_test"), gate_(gate) {}
+
+  bool Update(const string& key, const string& value) override {
+    if (writes_at_gate_++ == 0)
+      first_write_.set_value();
+    gate_.wait();
+    return TestDb::Update(key, value);
+  }
+
+  std::future<void> first_write() { return first_write_.get_future(); }
+
+ private:
+  std::shared_future<void> gate_;
+  std::atomic<int> writes_at_gate_{0};
+  std::promise<void> first_write_;
+};
+
+TEST(RimeUserDbTest, AsyncLearningDoesNotBlockInput) {
+  std::promise<void> gate;
+  auto db = New<GatedDb>(gate.get_future().share());
+  auto first_write = db->first_write();
+  if (db->Exists())
+    db->Remove();
+  ASSERT_TRUE(db->Open());
+  {
+    UserDictionary user_dict("user_db_test", db);
+    ASSERT_TRUE(user_dict.Load());
+    user_dict.EnableAsyncLearning(New<std::mutex>());
+    DictEntry entry;
+    entry.custom_code = "abc ";
+    entry.text = "ABC";
+    // returns while the write is held up on the worker thread
+    ASSERT_TRUE(user_dict.UpdateEntry(entry, 1));
+    EXPECT_EQ(1, user_dict.tick());
+    ASSERT_EQ(std::future_status::ready,
+              first_write.wait_for(std::chrono::seconds(5)));
+    string value;
+    EXPECT_FALSE(db->Fetch("abc \tABC", &value));
+    gate.set_value();
+    // queued writes are seen by lookups before they are done
+    user_dict.NewTransaction();
+    user_dict.UpdateEntry(entry, 1);
+    user_dict.CommitPendingTransaction();
+    UserDictEntryIterator result;
+    EXPECT_EQ(1, user_dict.LookupWords(&result, "abc", false));
+    EXPECT_EQ(2, user_dict.tick());
+    user_dict.WaitForLearning();
+    ASSERT_TRUE(db->Fetch("abc \tABC", &value));
+    EXPECT_EQ(2, UserDbValue(value).commits);
+  }
+  db->Close();
+}
@@ -0,0 +1,285 @@
+//
+// Copyright RIME Developers
+// Distributed under the BSD License
+//
+// End-to-end latency benchmark: deploys a schema, replays key sequences
+// from corpus files through the Rime API and prints the results as JSON.
+//
+// usage: rime_bench [options] corpus_file...
+//   --schema <schema_id>        schema to benchmark (default: luna_pinyin)
+//   --shared-data-dir <dir>     (default: .)
+//   --user-data-dir <dir>       (default: rime_bench_user)
+//   --iterations <n>            measured passes over the corpus (default: 5)
+//   --warmup <n>                passes before measuring (default: 1)
+//
+// Each line of a corpus file is a key sequence, eg. "nihao{space}".
+// Lines starting with '#' are comments. The composition is cleared after
+// each line. A keystroke is timed from process_key() through get_context(),
+// the way a front end would see it.
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <rime_api.h>
+#include <rime/key_event.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using std::string;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+  string schema_id = "luna_pinyin";
+  string shared_data_dir = ".";
+  string user_data_dir = "rime_bench_user";
+  int iterations = 5;
+  int warmup = 1;
+  vector<string> corpus_files;
+};
+
+struct CorpusLine {
+  rime::KeySequence keys;
+};
+
+static size_t peak_rss_kb() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return counters.PeakWorkingSetSize / 1024;
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;  // in bytes
+#else
+  return usage.ru_maxrss;  // in kilobytes
+#endif
+#endif
+}
+
+static double elapsed_us(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// nearest-rank percentile of sorted samples
+static double percentile(const vector<double>& sorted, double p) {
+  if (sorted.empty())
+    return 0.0;
+  size_t rank = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+  return sorted[(std::min)(rank, sorted.size() - 1)];
+}
+
+static string json_escape(const string& str) {
+  string escaped;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      escaped += buffer;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+static bool parse_options(int argc, char* argv[], BenchOptions* options) {
+  for (int i = 1; i < argc; ++i) {
+    string arg(argv[i]);
+    bool has_value = i + 1 < argc;
+    if (arg == "--schema" && has_value) {
+      options->schema_id = argv[++i];
+    } else if (arg == "--shared-data-dir" && has_value) {
+      options->shared_data_dir = argv[++i];
+    } else if (arg == "--user-data-dir" && has_value) {
+      options->user_data_dir = argv[++i];
+    } else if (arg == "--iterations" && has_value) {
+      options->iterations = std::atoi(argv[++i]);
+    } else if (arg == "--warmup" && has_value) {
+      options->warmup = std::atoi(argv[++i]);
+    } else if (arg.compare(0, 2, "--") == 0) {
+      std::cerr << "unknown option: " << arg << std::endl;
+      return false;
+    } else {
+      options->corpus_files.push_back(arg);
+    }
+  }
+  return !options->corpus_files.empty() && options->iterations > 0 &&
+         options->warmup >= 0;
+}
+
+static bool load_corpus(const string& file_name, vector<CorpusLine>* corpus) {
+  std::ifstream fin(file_name.c_str());
+  if (!fin) {
+    std::cerr << "error opening corpus file: " << file_name << std::endl;
+    return false;
+  }
+  string line;
+  int line_no = 0;
+  while (std::getline(fin, line)) {
+    ++line_no;
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line.empty() || line[0] == '#')
+      continue;
+    CorpusLine entry;
+    if (!entry.keys.Parse(line)) {
+      std::cerr << file_name << ":" << line_no
+                << ": invalid key sequence: " << line << std::endl;
+      return false;
+    }
+    corpus->push_back(std::move(entry));
+  }
+  return true;
+}
+
+// returns false if the engine rejects the session
+static bool replay(RimeApi* rime,
+                   RimeSessionId session_id,
+                   const vector<CorpusLine>& corpus,
+                   vector<double>* latencies) {
+  for (const auto& line : corpus) {
+    for (const auto& key : line.keys) {
+      auto start = Clock::now();
+      rime->process_key(session_id, key.keycode(), key.modifier());
+      RIME_STRUCT(RimeContext, context);
+      if (rime->get_context(session_id, &context)) {
+        rime->free_context(&context);
+      }
+      auto end = Clock::now();
+      if (latencies) {
+        latencies->push_back(elapsed_us(start, end));
+      }
+    }
+    RIME_STRUCT(RimeCommit, commit);
+    if (rime->get_commit(session_id, &commit)) {
+      rime->free_commit(&commit);
+    }
+    rime->clear_composition(session_id);
+    if (!rime->find_session(session_id))
+      return false;
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  BenchOptions options;
+  if (!parse_options(argc, argv, &options)) {
+    std::cerr << "usage: rime_bench [--schema <schema_id>] "
+                 "[--shared-data-dir <dir>] [--user-data-dir <dir>] "
+                 "[--iterations <n>] [--warmup <n>] corpus_file..."
+              << std::endl;
+    return 1;
+  }
+  vector<CorpusLine> corpus;
+  for (const auto& file_name : options.corpus_files) {
+    if (!load_corpus(file_name, &corpus))
+      return 1;
+  }
+  size_t keys_per_pass = 0;
+  for (const auto& line : corpus) {
+    keys_per_pass += line.keys.size();
+  }
+  if (!keys_per_pass) {
+    std::cerr << "empty corpus." << std::endl;
+    return 1;
+  }
+
+  RimeApi* rime = rime_get_api();
+  RIME_STRUCT(RimeTraits, traits);
+  traits.shared_data_dir = options.shared_data_dir.c_str();
+  traits.user_data_dir = options.user_data_dir.c_str();
+  traits.app_name = "rime.bench";
+  traits.min_log_level = 2;  // ERROR
+  rime->setup(&traits);
+
+  auto deploy_start = Clock::now();
+  rime->initialize(NULL);
+  if (rime->start_maintenance(True))
+    rime->join_maintenance_thread();
+  auto deploy_end = Clock::now();
+
+  auto session_start = Clock::now();
+  RimeSessionId session_id = rime->create_session();
+  if (!session_id ||
+      !rime->select_schema(session_id, options.schema_id.c_str())) {
+    std::cerr << "error selecting schema: " << options.schema_id << std::endl;
+    rime->finalize();
+    return 1;
+  }
+  auto session_end = Clock::now();
+
+  for (int i = 0; i < options.warmup; ++i) {
+    replay(rime, session_id, corpus, nullptr);
+  }
+  vector<double> latencies;
+  latencies.reserve(keys_per_pass * options.iterations);
+  auto bench_start = Clock::now();
+  for (int i = 0; i < options.iterations; ++i) {
+    if (!replay(rime, session_id, corpus, &latencies)) {
+      std::cerr << "session lost during replay." << std::endl;
+      rime->finalize();
+      return 1;
+    }
+  }
+  auto bench_end = Clock::now();
+
+  rime->destroy_session(session_id);
+  rime->finalize();
+
+  double total_us = elapsed_us(bench_start, bench_end);
+  double sum_us = 0.0;
+  for (double x : latencies) {
+    sum_us += x;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  double mean_us = latencies.empty() ? 0.0 : sum_us / latencies.size();
+  double keys_per_second =
+      total_us > 0.0 ? latencies.size() / (total_us / 1e6) : 0.0;
+
+  std::cout << "{" << std::endl;
+  std::cout << "  \"schema\": \"" << json_escape(options.schema_id) << "\","
+            << std::endl;
+  std::cout << "  \"corpus\": [";
+  for (size_t i = 0; i < options.corpus_files.size(); ++i) {
+    std::cout << (i ? ", " : "") << "\""
+              << json_escape(options.corpus_files[i]) << "\"";
+  }
+  std::cout << "]," << std::endl;
+  std::cout << "  \"iterations\": " << options.iterations << "," << std::endl;
+  std::cout << "  \"keystrokes\": " << latencies.size() << "," << std::endl;
+  std::cout << "  \"deploy_ms\": "
+            << elapsed_us(deploy_start, deploy_end) / 1000.0 << ","
+            << std::endl;
+  std::cout << "  \"session_start_ms\": "
+            << elapsed_us(session_start, session_end) / 1000.0 << ","
+            << std::endl;
+  std::cout << "  \"latency_us\": {"
+            << "\"mean\": " << mean_us
+            << ", \"p50\": " << percentile(latencies, 50)
+            << ", \"p90\": " << percentile(latencies, 90)
+            << ", \"p99\": " << percentile(latencies, 99)
+            << ", \"max\": " << (latencies.empty() ? 0.0 : latencies.back())
+            << "}," << std::endl;
+  std::cout << "  \"throughput_keys_per_sec\": " << keys_per_second << ","
+            << std::endl;
+  std::cout << "  \"peak_rss_kb\": " << peak_rss_kb() << std::endl;
+  std::cout << "}" << std::endl;
+  return 0;
+}
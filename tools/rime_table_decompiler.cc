@@ -37,7 +37,7 @@ void access(rime::Table* table,
     fout << word << "\t";
     outCode(table, accessor.code(), fout);
 
-    auto weight = accessor.entry()->weight;
+    auto weight = accessor.entry()->weight();
     if (weight >= 0) {
       fout << "\t" << exp(weight);
     }